@@ -38,7 +38,13 @@ PLUGIN_EXPORT bool PLUGIN_CALL OnPlayerConnect(int playerid)
 
 PLUGIN_EXPORT bool PLUGIN_CALL OnPlayerDisconnect(int playerid, int reason)
 {
-	core->getData()->players.erase(playerid);
+	boost::unordered_map<int, Player>::iterator p = core->getData()->players.find(playerid);
+	if (p != core->getData()->players.end())
+	{
+		Utility::setPlayerDrivenVehicle(playerid, INVALID_VEHICLE_ID);
+		core->getStreamer()->releasePlayerReferences(p->second);
+		core->getData()->players.erase(p);
+	}
 	return true;
 }
 
@@ -62,6 +68,19 @@ PLUGIN_EXPORT bool PLUGIN_CALL OnPlayerRequestClass(int playerid, int classid)
 	return true;
 }
 
+PLUGIN_EXPORT bool PLUGIN_CALL OnPlayerStateChange(int playerid, int newstate, int oldstate)
+{
+	if (newstate == PLAYER_STATE_DRIVER)
+	{
+		Utility::setPlayerDrivenVehicle(playerid, sampgdk::GetPlayerVehicleID(playerid));
+	}
+	else if (oldstate == PLAYER_STATE_DRIVER)
+	{
+		Utility::setPlayerDrivenVehicle(playerid, INVALID_VEHICLE_ID);
+	}
+	return true;
+}
+
 PLUGIN_EXPORT bool PLUGIN_CALL OnPlayerEnterCheckpoint(int playerid)
 {
 	boost::unordered_map<int, Player>::iterator p = core->getData()->players.find(playerid);
@@ -74,7 +93,7 @@ PLUGIN_EXPORT bool PLUGIN_CALL OnPlayerEnterCheckpoint(int playerid)
 			for (std::set<AMX*>::iterator a = core->getData()->interfaces.begin(); a != core->getData()->interfaces.end(); ++a)
 			{
 				int amxIndex = 0;
-				if (!amx_FindPublic(*a, "OnPlayerEnterDynamicCP", &amxIndex))
+				if (Utility::findPublic(*a, STREAMER_CALLBACK_ON_PLAYER_ENTER_DYNAMIC_CP, amxIndex))
 				{
 					amx_Push(*a, static_cast<cell>(checkpointid));
 					amx_Push(*a, static_cast<cell>(playerid));
@@ -98,7 +117,7 @@ PLUGIN_EXPORT bool PLUGIN_CALL OnPlayerLeaveCheckpoint(int playerid)
 			for (std::set<AMX*>::iterator a = core->getData()->interfaces.begin(); a != core->getData()->interfaces.end(); ++a)
 			{
 				int amxIndex = 0;
-				if (!amx_FindPublic(*a, "OnPlayerLeaveDynamicCP", &amxIndex))
+				if (Utility::findPublic(*a, STREAMER_CALLBACK_ON_PLAYER_LEAVE_DYNAMIC_CP, amxIndex))
 				{
 					amx_Push(*a, static_cast<cell>(checkpointid));
 					amx_Push(*a, static_cast<cell>(playerid));
@@ -122,7 +141,7 @@ PLUGIN_EXPORT bool PLUGIN_CALL OnPlayerEnterRaceCheckpoint(int playerid)
 			for (std::set<AMX*>::iterator a = core->getData()->interfaces.begin(); a != core->getData()->interfaces.end(); ++a)
 			{
 				int amxIndex = 0;
-				if (!amx_FindPublic(*a, "OnPlayerEnterDynamicRaceCP", &amxIndex))
+				if (Utility::findPublic(*a, STREAMER_CALLBACK_ON_PLAYER_ENTER_DYNAMIC_RACE_CP, amxIndex))
 				{
 					amx_Push(*a, static_cast<cell>(checkpointid));
 					amx_Push(*a, static_cast<cell>(playerid));
@@ -146,7 +165,7 @@ PLUGIN_EXPORT bool PLUGIN_CALL OnPlayerLeaveRaceCheckpoint(int playerid)
 			for (std::set<AMX*>::iterator a = core->getData()->interfaces.begin(); a != core->getData()->interfaces.end(); ++a)
 			{
 				int amxIndex = 0;
-				if (!amx_FindPublic(*a, "OnPlayerLeaveDynamicRaceCP", &amxIndex))
+				if (Utility::findPublic(*a, STREAMER_CALLBACK_ON_PLAYER_LEAVE_DYNAMIC_RACE_CP, amxIndex))
 				{
 					amx_Push(*a, static_cast<cell>(checkpointid));
 					amx_Push(*a, static_cast<cell>(playerid));
@@ -160,69 +179,62 @@ PLUGIN_EXPORT bool PLUGIN_CALL OnPlayerLeaveRaceCheckpoint(int playerid)
 
 PLUGIN_EXPORT bool PLUGIN_CALL OnPlayerPickUpPickup(int playerid, int pickupid)
 {
-	for (boost::unordered_map<int, int>::iterator i = core->getData()->internalPickups.begin(); i != core->getData()->internalPickups.end(); ++i)
+	boost::unordered_map<int, int>::iterator i = core->getData()->internalPickups.find(core->getData()->reversePickups.find(pickupid));
+	if (i != core->getData()->internalPickups.end())
 	{
-		if (i->second == pickupid)
+		int pickupid = i->first;
+		for (std::set<AMX*>::iterator a = core->getData()->interfaces.begin(); a != core->getData()->interfaces.end(); ++a)
 		{
-			int pickupid = i->first;
-			for (std::set<AMX*>::iterator a = core->getData()->interfaces.begin(); a != core->getData()->interfaces.end(); ++a)
+			int amxIndex = 0;
+			if (Utility::findPublic(*a, STREAMER_CALLBACK_ON_PLAYER_PICK_UP_DYNAMIC_PICKUP, amxIndex))
 			{
-				int amxIndex = 0;
-				if (!amx_FindPublic(*a, "OnPlayerPickUpDynamicPickup", &amxIndex))
-				{
-					amx_Push(*a, static_cast<cell>(pickupid));
-					amx_Push(*a, static_cast<cell>(playerid));
-					amx_Exec(*a, NULL, amxIndex);
-				}
+				amx_Push(*a, static_cast<cell>(pickupid));
+				amx_Push(*a, static_cast<cell>(playerid));
+				amx_Exec(*a, NULL, amxIndex);
 			}
-			break;
 		}
 	}
 	return true;
 }
 
-PLUGIN_EXPORT bool PLUGIN_CALL OnPlayerEditObject(int playerid, bool playerobject, int objectid, int response, float fX, float fY, float fZ, float fRotX, float fRotY, float fRotZ)
+PLUGIN_EXPORT bool PLUGIN_CALL OnPlayerEditObject(int playerid, bool playerobject, int internalid, int response, float fX, float fY, float fZ, float fRotX, float fRotY, float fRotZ)
 {
 	if (playerobject)
 	{
 		boost::unordered_map<int, Player>::iterator p = core->getData()->players.find(playerid);
 		if (p != core->getData()->players.end())
 		{
-			for (boost::unordered_map<int, int>::iterator i = p->second.internalObjects.begin(); i != p->second.internalObjects.end(); ++i)
+			int objectid = p->second.reverseObjects.find(internalid);
+			if (objectid != INVALID_STREAMER_ID)
 			{
-				if (i->second == objectid)
+				if (response == EDIT_RESPONSE_CANCEL || response == EDIT_RESPONSE_FINAL)
 				{
-					int objectid = i->first;
-					if (response == EDIT_RESPONSE_CANCEL || response == EDIT_RESPONSE_FINAL)
+					boost::unordered_map<int, Item::SharedObject>::iterator o = core->getData()->objects.find(objectid);
+					if (o != core->getData()->objects.end())
 					{
-						boost::unordered_map<int, Item::SharedObject>::iterator o = core->getData()->objects.find(objectid);
-						if (o != core->getData()->objects.end())
+						if (o->second->comparableStreamDistance < STREAMER_STATIC_DISTANCE_CUTOFF && o->second->originalComparableStreamDistance > STREAMER_STATIC_DISTANCE_CUTOFF)
 						{
-							if (o->second->comparableStreamDistance < STREAMER_STATIC_DISTANCE_CUTOFF && o->second->originalComparableStreamDistance > STREAMER_STATIC_DISTANCE_CUTOFF)
-							{
-								o->second->comparableStreamDistance = o->second->originalComparableStreamDistance;
-								o->second->originalComparableStreamDistance = -1.0f;
-							}
+							o->second->comparableStreamDistance = o->second->originalComparableStreamDistance;
+							o->second->originalComparableStreamDistance = -1.0f;
 						}
 					}
-					for (std::set<AMX*>::iterator a = core->getData()->interfaces.begin(); a != core->getData()->interfaces.end(); ++a)
+				}
+				for (std::set<AMX*>::iterator a = core->getData()->interfaces.begin(); a != core->getData()->interfaces.end(); ++a)
+				{
+					int amxIndex = 0;
+					if (Utility::findPublic(*a, STREAMER_CALLBACK_ON_PLAYER_EDIT_DYNAMIC_OBJECT, amxIndex))
 					{
-						int amxIndex = 0;
-						if (!amx_FindPublic(*a, "OnPlayerEditDynamicObject", &amxIndex))
-						{
-							amx_Push(*a, amx_ftoc(fRotZ));
-							amx_Push(*a, amx_ftoc(fRotY));
-							amx_Push(*a, amx_ftoc(fRotX));
-							amx_Push(*a, amx_ftoc(fZ));
-							amx_Push(*a, amx_ftoc(fY));
-							amx_Push(*a, amx_ftoc(fX));
-							amx_Push(*a, static_cast<cell>(response));
-							amx_Push(*a, static_cast<cell>(objectid));
-							amx_Push(*a, static_cast<cell>(playerid));
-							amx_Exec(*a, NULL, amxIndex);
-						}
+						amx_Push(*a, amx_ftoc(fRotZ));
+						amx_Push(*a, amx_ftoc(fRotY));
+						amx_Push(*a, amx_ftoc(fRotX));
+						amx_Push(*a, amx_ftoc(fZ));
+						amx_Push(*a, amx_ftoc(fY));
+						amx_Push(*a, amx_ftoc(fX));
+						amx_Push(*a, static_cast<cell>(response));
+						amx_Push(*a, static_cast<cell>(objectid));
+						amx_Push(*a, static_cast<cell>(playerid));
+						amx_Exec(*a, NULL, amxIndex);
 					}
-					break;
 				}
 			}
 		}
@@ -230,33 +242,29 @@ PLUGIN_EXPORT bool PLUGIN_CALL OnPlayerEditObject(int playerid, bool playerobjec
 	return false;
 }
 
-PLUGIN_EXPORT bool PLUGIN_CALL OnPlayerSelectObject(int playerid, int type, int objectid, int modelid, float x, float y, float z)
+PLUGIN_EXPORT bool PLUGIN_CALL OnPlayerSelectObject(int playerid, int type, int internalid, int modelid, float x, float y, float z)
 {
 	if (type == SELECT_OBJECT_PLAYER_OBJECT)
 	{
 		boost::unordered_map<int, Player>::iterator p = core->getData()->players.find(playerid);
 		if (p != core->getData()->players.end())
 		{
-			for (boost::unordered_map<int, int>::iterator i = p->second.internalObjects.begin(); i != p->second.internalObjects.end(); ++i)
+			int objectid = p->second.reverseObjects.find(internalid);
+			if (objectid != INVALID_STREAMER_ID)
 			{
-				if (i->second == objectid)
+				for (std::set<AMX*>::iterator a = core->getData()->interfaces.begin(); a != core->getData()->interfaces.end(); ++a)
 				{
-					int objectid = i->first;
-					for (std::set<AMX*>::iterator a = core->getData()->interfaces.begin(); a != core->getData()->interfaces.end(); ++a)
+					int amxIndex = 0;
+					if (Utility::findPublic(*a, STREAMER_CALLBACK_ON_PLAYER_SELECT_DYNAMIC_OBJECT, amxIndex))
 					{
-						int amxIndex = 0;
-						if (!amx_FindPublic(*a, "OnPlayerSelectDynamicObject", &amxIndex))
-						{
-							amx_Push(*a, amx_ftoc(z));
-							amx_Push(*a, amx_ftoc(y));
-							amx_Push(*a, amx_ftoc(x));
-							amx_Push(*a, static_cast<cell>(modelid));
-							amx_Push(*a, static_cast<cell>(objectid));
-							amx_Push(*a, static_cast<cell>(playerid));
-							amx_Exec(*a, NULL, amxIndex);
-						}
+						amx_Push(*a, amx_ftoc(z));
+						amx_Push(*a, amx_ftoc(y));
+						amx_Push(*a, amx_ftoc(x));
+						amx_Push(*a, static_cast<cell>(modelid));
+						amx_Push(*a, static_cast<cell>(objectid));
+						amx_Push(*a, static_cast<cell>(playerid));
+						amx_Exec(*a, NULL, amxIndex);
 					}
-					break;
 				}
 			}
 		}
@@ -272,52 +280,19 @@ PLUGIN_EXPORT bool PLUGIN_CALL OnPlayerWeaponShot(int playerid, int weaponid, in
 		boost::unordered_map<int, Player>::iterator p = core->getData()->players.find(playerid);
 		if (p != core->getData()->players.end())
 		{
-			for (boost::unordered_map<int, int>::iterator i = p->second.internalObjects.begin(); i != p->second.internalObjects.end(); ++i)
+			int objectid = p->second.reverseObjects.find(hitid);
+			if (objectid != INVALID_STREAMER_ID)
 			{
-				if (i->second == hitid)
-				{
-					int objectid = i->first;
-					for (std::set<AMX*>::iterator a = core->getData()->interfaces.begin(); a != core->getData()->interfaces.end(); ++a)
-					{
-						int amxIndex = 0;
-						cell amxRetVal = 0;
-						if (!amx_FindPublic(*a, "OnPlayerShootDynamicObject", &amxIndex))
-						{
-							amx_Push(*a, amx_ftoc(z));
-							amx_Push(*a, amx_ftoc(y));
-							amx_Push(*a, amx_ftoc(x));
-							amx_Push(*a, static_cast<cell>(objectid));
-							amx_Push(*a, static_cast<cell>(weaponid));
-							amx_Push(*a, static_cast<cell>(playerid));
-							amx_Exec(*a, &amxRetVal, amxIndex);
-							if (!amxRetVal)
-							{
-								retVal = false;
-							}
-						}
-					}
-					break;
-				}
-			}
-		}
-	}
-	else if (hittype == BULLET_HIT_TYPE_VEHICLE)
-	{
-		for (boost::unordered_map<int, int>::iterator i = core->getData()->internalVehicles.begin(); i != core->getData()->internalVehicles.end(); ++i)
-		{
-			if (i->second == hitid)
-			{
-				int vehicleid = i->first;
 				for (std::set<AMX*>::iterator a = core->getData()->interfaces.begin(); a != core->getData()->interfaces.end(); ++a)
 				{
 					int amxIndex = 0;
 					cell amxRetVal = 0;
-					if (!amx_FindPublic(*a, "OnPlayerShootDynamicVehicle", &amxIndex))
+					if (Utility::findPublic(*a, STREAMER_CALLBACK_ON_PLAYER_SHOOT_DYNAMIC_OBJECT, amxIndex))
 					{
 						amx_Push(*a, amx_ftoc(z));
 						amx_Push(*a, amx_ftoc(y));
 						amx_Push(*a, amx_ftoc(x));
-						amx_Push(*a, static_cast<cell>(vehicleid));
+						amx_Push(*a, static_cast<cell>(objectid));
 						amx_Push(*a, static_cast<cell>(weaponid));
 						amx_Push(*a, static_cast<cell>(playerid));
 						amx_Exec(*a, &amxRetVal, amxIndex);
@@ -327,34 +302,57 @@ PLUGIN_EXPORT bool PLUGIN_CALL OnPlayerWeaponShot(int playerid, int weaponid, in
 						}
 					}
 				}
-				break;
 			}
 		}
 	}
-	return retVal;
-}
-
-PLUGIN_EXPORT bool PLUGIN_CALL OnPlayerGiveDamageActor(int playerid, int actorid, float amount, int weaponid, int bodypart)
-{
-	for (boost::unordered_map<int, int>::iterator i = core->getData()->internalActors.begin(); i != core->getData()->internalActors.end(); ++i)
+	else if (hittype == BULLET_HIT_TYPE_VEHICLE)
 	{
-		if (i->second == actorid)
+		boost::unordered_map<int, int>::iterator i = core->getData()->internalVehicles.find(core->getData()->reverseVehicles.find(hitid));
+		if (i != core->getData()->internalVehicles.end())
 		{
-			int actorid = i->first;
+			int vehicleid = i->first;
 			for (std::set<AMX*>::iterator a = core->getData()->interfaces.begin(); a != core->getData()->interfaces.end(); ++a)
 			{
 				int amxIndex = 0;
-				if (!amx_FindPublic(*a, "OnPlayerGiveDamageDynamicActor", &amxIndex))
+				cell amxRetVal = 0;
+				if (Utility::findPublic(*a, STREAMER_CALLBACK_ON_PLAYER_SHOOT_DYNAMIC_VEHICLE, amxIndex))
 				{
-					amx_Push(*a, static_cast<cell>(bodypart));
+					amx_Push(*a, amx_ftoc(z));
+					amx_Push(*a, amx_ftoc(y));
+					amx_Push(*a, amx_ftoc(x));
+					amx_Push(*a, static_cast<cell>(vehicleid));
 					amx_Push(*a, static_cast<cell>(weaponid));
-					amx_Push(*a, amx_ftoc(amount));
-					amx_Push(*a, static_cast<cell>(actorid));
 					amx_Push(*a, static_cast<cell>(playerid));
-					amx_Exec(*a, NULL, amxIndex);
+					amx_Exec(*a, &amxRetVal, amxIndex);
+					if (!amxRetVal)
+					{
+						retVal = false;
+					}
 				}
 			}
-			break;
+		}
+	}
+	return retVal;
+}
+
+PLUGIN_EXPORT bool PLUGIN_CALL OnPlayerGiveDamageActor(int playerid, int actorid, float amount, int weaponid, int bodypart)
+{
+	boost::unordered_map<int, int>::iterator i = core->getData()->internalActors.find(core->getData()->reverseActors.find(actorid));
+	if (i != core->getData()->internalActors.end())
+	{
+		int actorid = i->first;
+		for (std::set<AMX*>::iterator a = core->getData()->interfaces.begin(); a != core->getData()->interfaces.end(); ++a)
+		{
+			int amxIndex = 0;
+			if (Utility::findPublic(*a, STREAMER_CALLBACK_ON_PLAYER_GIVE_DAMAGE_DYNAMIC_ACTOR, amxIndex))
+			{
+				amx_Push(*a, static_cast<cell>(bodypart));
+				amx_Push(*a, static_cast<cell>(weaponid));
+				amx_Push(*a, amx_ftoc(amount));
+				amx_Push(*a, static_cast<cell>(actorid));
+				amx_Push(*a, static_cast<cell>(playerid));
+				amx_Exec(*a, NULL, amxIndex);
+			}
 		}
 	}
 	return true;
@@ -362,22 +360,19 @@ PLUGIN_EXPORT bool PLUGIN_CALL OnPlayerGiveDamageActor(int playerid, int actorid
 
 PLUGIN_EXPORT bool PLUGIN_CALL OnActorStreamIn(int actorid, int forplayerid)
 {
-	for (boost::unordered_map<int, int>::iterator i = core->getData()->internalActors.begin(); i != core->getData()->internalActors.end(); ++i)
+	boost::unordered_map<int, int>::iterator i = core->getData()->internalActors.find(core->getData()->reverseActors.find(actorid));
+	if (i != core->getData()->internalActors.end())
 	{
-		if (i->second == actorid)
+		int actorid = i->first;
+		for (std::set<AMX*>::iterator a = core->getData()->interfaces.begin(); a != core->getData()->interfaces.end(); ++a)
 		{
-			int actorid = i->first;
-			for (std::set<AMX*>::iterator a = core->getData()->interfaces.begin(); a != core->getData()->interfaces.end(); ++a)
+			int amxIndex = 0;
+			if (Utility::findPublic(*a, STREAMER_CALLBACK_ON_DYNAMIC_ACTOR_STREAM_IN, amxIndex))
 			{
-				int amxIndex = 0;
-				if (!amx_FindPublic(*a, "OnDynamicActorStreamIn", &amxIndex))
-				{
-					amx_Push(*a, static_cast<cell>(forplayerid));
-					amx_Push(*a, static_cast<cell>(actorid));
-					amx_Exec(*a, NULL, amxIndex);
-				}
+				amx_Push(*a, static_cast<cell>(forplayerid));
+				amx_Push(*a, static_cast<cell>(actorid));
+				amx_Exec(*a, NULL, amxIndex);
 			}
-			break;
 		}
 	}
 	return true;
@@ -385,22 +380,19 @@ PLUGIN_EXPORT bool PLUGIN_CALL OnActorStreamIn(int actorid, int forplayerid)
 
 PLUGIN_EXPORT bool PLUGIN_CALL OnActorStreamOut(int actorid, int forplayerid)
 {
-	for (boost::unordered_map<int, int>::iterator i = core->getData()->internalActors.begin(); i != core->getData()->internalActors.end(); ++i)
+	boost::unordered_map<int, int>::iterator i = core->getData()->internalActors.find(core->getData()->reverseActors.find(actorid));
+	if (i != core->getData()->internalActors.end())
 	{
-		if (i->second == actorid)
+		int actorid = i->first;
+		for (std::set<AMX*>::iterator a = core->getData()->interfaces.begin(); a != core->getData()->interfaces.end(); ++a)
 		{
-			int actorid = i->first;
-			for (std::set<AMX*>::iterator a = core->getData()->interfaces.begin(); a != core->getData()->interfaces.end(); ++a)
+			int amxIndex = 0;
+			if (Utility::findPublic(*a, STREAMER_CALLBACK_ON_DYNAMIC_ACTOR_STREAM_OUT, amxIndex))
 			{
-				int amxIndex = 0;
-				if (!amx_FindPublic(*a, "OnDynamicActorStreamOut", &amxIndex))
-				{
-					amx_Push(*a, static_cast<cell>(forplayerid));
-					amx_Push(*a, static_cast<cell>(actorid));
-					amx_Exec(*a, NULL, amxIndex);
-				}
+				amx_Push(*a, static_cast<cell>(forplayerid));
+				amx_Push(*a, static_cast<cell>(actorid));
+				amx_Exec(*a, NULL, amxIndex);
 			}
-			break;
 		}
 	}
 	return true;
@@ -408,29 +400,26 @@ PLUGIN_EXPORT bool PLUGIN_CALL OnActorStreamOut(int actorid, int forplayerid)
 
 PLUGIN_EXPORT bool PLUGIN_CALL OnVehicleSpawn(int vehicleid)
 {
-	for (boost::unordered_map<int, int>::iterator i = core->getData()->internalVehicles.begin(); i != core->getData()->internalVehicles.end(); ++i)
+	boost::unordered_map<int, int>::iterator i = core->getData()->internalVehicles.find(core->getData()->reverseVehicles.find(vehicleid));
+	if (i != core->getData()->internalVehicles.end())
 	{
-		if (i->second == vehicleid)
+		for (std::set<AMX*>::iterator a = core->getData()->interfaces.begin(); a != core->getData()->interfaces.end(); ++a)
 		{
-			for (std::set<AMX*>::iterator a = core->getData()->interfaces.begin(); a != core->getData()->interfaces.end(); ++a)
+			int amxIndex = 0;
+			if (Utility::findPublic(*a, STREAMER_CALLBACK_ON_DYNAMIC_VEHICLE_SPAWN, amxIndex))
 			{
-				int amxIndex = 0;
-				if (!amx_FindPublic(*a, "OnDynamicVehicleSpawn", &amxIndex))
-				{
-					amx_Push(*a, static_cast<cell>(i->first));
-					amx_Exec(*a, NULL, amxIndex);
-				}
+				amx_Push(*a, static_cast<cell>(i->first));
+				amx_Exec(*a, NULL, amxIndex);
 			}
-			boost::unordered_map<int, Item::SharedVehicle>::iterator p = core->getData()->vehicles.find(i->first);
-			if (p != core->getData()->vehicles.end())
-			{
-				// For testing purpose
-				// core->getStreamer()->movingVehicles.insert(p->second);
+		}
+		boost::unordered_map<int, Item::SharedVehicle>::iterator p = core->getData()->vehicles.find(i->first);
+		if (p != core->getData()->vehicles.end())
+		{
+			// For testing purpose
+			// core->getStreamer()->movingVehicles.insert(p->second);
 
-				p->second->touched = false;
-				p->second->used = false;
-			}
-			break;
+			p->second->touched = false;
+			p->second->used = false;
 		}
 	}
 	return true;
@@ -438,21 +427,18 @@ PLUGIN_EXPORT bool PLUGIN_CALL OnVehicleSpawn(int vehicleid)
 
 PLUGIN_EXPORT bool PLUGIN_CALL OnVehicleDeath(int vehicleid, int killerid)
 {
-	for (boost::unordered_map<int, int>::iterator i = core->getData()->internalVehicles.begin(); i != core->getData()->internalVehicles.end(); ++i)
+	boost::unordered_map<int, int>::iterator i = core->getData()->internalVehicles.find(core->getData()->reverseVehicles.find(vehicleid));
+	if (i != core->getData()->internalVehicles.end())
 	{
-		if (i->second == vehicleid)
+		for (std::set<AMX*>::iterator a = core->getData()->interfaces.begin(); a != core->getData()->interfaces.end(); ++a)
 		{
-			for (std::set<AMX*>::iterator a = core->getData()->interfaces.begin(); a != core->getData()->interfaces.end(); ++a)
+			int amxIndex = 0;
+			if (Utility::findPublic(*a, STREAMER_CALLBACK_ON_DYNAMIC_VEHICLE_DEATH, amxIndex))
 			{
-				int amxIndex = 0;
-				if (!amx_FindPublic(*a, "OnDynamicVehicleDeath", &amxIndex))
-				{
-					amx_Push(*a, static_cast<cell>(killerid));
-					amx_Push(*a, static_cast<cell>(i->first));
-					amx_Exec(*a, NULL, amxIndex);
-				}
+				amx_Push(*a, static_cast<cell>(killerid));
+				amx_Push(*a, static_cast<cell>(i->first));
+				amx_Exec(*a, NULL, amxIndex);
 			}
-			break;
 		}
 	}
 	return true;
@@ -460,35 +446,33 @@ PLUGIN_EXPORT bool PLUGIN_CALL OnVehicleDeath(int vehicleid, int killerid)
 
 PLUGIN_EXPORT bool PLUGIN_CALL OnPlayerEnterVehicle(int playerid, int vehicleid, bool ispassenger)
 {
-	for (boost::unordered_map<int, int>::iterator i = core->getData()->internalVehicles.begin(); i != core->getData()->internalVehicles.end(); ++i)
+	boost::unordered_map<int, int>::iterator i = core->getData()->internalVehicles.find(core->getData()->reverseVehicles.find(vehicleid));
+	if (i != core->getData()->internalVehicles.end())
 	{
-		if (i->second == vehicleid)
+		for (std::set<AMX*>::iterator a = core->getData()->interfaces.begin(); a != core->getData()->interfaces.end(); ++a)
 		{
-			for (std::set<AMX*>::iterator a = core->getData()->interfaces.begin(); a != core->getData()->interfaces.end(); ++a)
+			int amxIndex = 0;
+			if (Utility::findPublic(*a, STREAMER_CALLBACK_ON_PLAYER_ENTER_DYNAMIC_VEHICLE, amxIndex))
 			{
-				int amxIndex = 0;
-				if (!amx_FindPublic(*a, "OnPlayerEnterDynamicVehicle", &amxIndex))
-				{
-					amx_Push(*a, static_cast<cell>(ispassenger));
-					amx_Push(*a, static_cast<cell>(i->first));
-					amx_Push(*a, static_cast<cell>(playerid));
-					amx_Exec(*a, NULL, amxIndex);
-				}
+				amx_Push(*a, static_cast<cell>(ispassenger));
+				amx_Push(*a, static_cast<cell>(i->first));
+				amx_Push(*a, static_cast<cell>(playerid));
+				amx_Exec(*a, NULL, amxIndex);
 			}
-			boost::unordered_map<int, Item::SharedVehicle>::iterator p = core->getData()->vehicles.find(i->first);
-			if (p != core->getData()->vehicles.end())
-			{
-				p->second->touched = true;
-				p->second->used = true;
+		}
+		boost::unordered_map<int, Item::SharedVehicle>::iterator p = core->getData()->vehicles.find(i->first);
+		if (p != core->getData()->vehicles.end())
+		{
+			p->second->touched = true;
+			p->second->used = true;
+			core->getStreamer()->scheduleVehicleRespawn(p->second);
 
-				//char msg[144];
-				//sprintf_s(msg, sizeof(msg), "internalid: %d, vehicleid: %d", i->second, i->first);
-				//sampgdk::SendClientMessage(playerid, -1, msg);
+			//char msg[144];
+			//sprintf_s(msg, sizeof(msg), "internalid: %d, vehicleid: %d", i->second, i->first);
+			//sampgdk::SendClientMessage(playerid, -1, msg);
 
-				core->getStreamer()->movingVehicles.insert(p->second);
-				p->second->lastUpdatedTime = boost::chrono::steady_clock::now();
-			}
-			break;
+			core->getStreamer()->movingVehicles.insert(p->second);
+			p->second->lastUpdatedTime = boost::chrono::steady_clock::now();
 		}
 	}
 	return true;
@@ -496,21 +480,18 @@ PLUGIN_EXPORT bool PLUGIN_CALL OnPlayerEnterVehicle(int playerid, int vehicleid,
 
 PLUGIN_EXPORT bool PLUGIN_CALL OnPlayerExitVehicle(int playerid, int vehicleid)
 {
-	for (boost::unordered_map<int, int>::iterator i = core->getData()->internalVehicles.begin(); i != core->getData()->internalVehicles.end(); ++i)
+	boost::unordered_map<int, int>::iterator i = core->getData()->internalVehicles.find(core->getData()->reverseVehicles.find(vehicleid));
+	if (i != core->getData()->internalVehicles.end())
 	{
-		if (i->second == vehicleid)
+		for (std::set<AMX*>::iterator a = core->getData()->interfaces.begin(); a != core->getData()->interfaces.end(); ++a)
 		{
-			for (std::set<AMX*>::iterator a = core->getData()->interfaces.begin(); a != core->getData()->interfaces.end(); ++a)
+			int amxIndex = 0;
+			if (Utility::findPublic(*a, STREAMER_CALLBACK_ON_PLAYER_EXIT_DYNAMIC_VEHICLE, amxIndex))
 			{
-				int amxIndex = 0;
-				if (!amx_FindPublic(*a, "OnPlayerExitDynamicVehicle", &amxIndex))
-				{
-					amx_Push(*a, static_cast<cell>(i->first));
-					amx_Push(*a, static_cast<cell>(playerid));
-					amx_Exec(*a, NULL, amxIndex);
-				}
+				amx_Push(*a, static_cast<cell>(i->first));
+				amx_Push(*a, static_cast<cell>(playerid));
+				amx_Exec(*a, NULL, amxIndex);
 			}
-			break;
 		}
 	}
 	return true;
@@ -519,38 +500,35 @@ PLUGIN_EXPORT bool PLUGIN_CALL OnPlayerExitVehicle(int playerid, int vehicleid)
 PLUGIN_EXPORT bool PLUGIN_CALL OnVehicleMod(int playerid, int vehicleid, int componentid)
 {
 	bool retVal = true;
-	for (boost::unordered_map<int, int>::iterator i = core->getData()->internalVehicles.begin(); i != core->getData()->internalVehicles.end(); ++i)
+	boost::unordered_map<int, int>::iterator i = core->getData()->internalVehicles.find(core->getData()->reverseVehicles.find(vehicleid));
+	if (i != core->getData()->internalVehicles.end())
 	{
-		if (i->second == vehicleid)
+		for (std::set<AMX*>::iterator a = core->getData()->interfaces.begin(); a != core->getData()->interfaces.end(); ++a)
 		{
-			for (std::set<AMX*>::iterator a = core->getData()->interfaces.begin(); a != core->getData()->interfaces.end(); ++a)
-			{
-				int amxIndex = 0;
-				cell amxRetVal = 1;
-				if (!amx_FindPublic(*a, "OnDynamicVehicleMod", &amxIndex))
+			int amxIndex = 0;
+			cell amxRetVal = 1;
+			if (Utility::findPublic(*a, STREAMER_CALLBACK_ON_DYNAMIC_VEHICLE_MOD, amxIndex))
+			{
+				amx_Push(*a, static_cast<cell>(componentid));
+				amx_Push(*a, static_cast<cell>(i->first));
+				amx_Push(*a, static_cast<cell>(playerid));
+				amx_Exec(*a, &amxRetVal, amxIndex);
+				if (amxRetVal == 0)
 				{
-					amx_Push(*a, static_cast<cell>(componentid));
-					amx_Push(*a, static_cast<cell>(i->first));
-					amx_Push(*a, static_cast<cell>(playerid));
-					amx_Exec(*a, &amxRetVal, amxIndex);
-					if (amxRetVal == 0)
-					{
-						retVal = false;
-					}
+					retVal = false;
 				}
 			}
-			if (retVal)
+		}
+		if (retVal)
+		{
+			boost::unordered_map<int, Item::SharedVehicle>::iterator p = core->getData()->vehicles.find(i->first);
+			if (p != core->getData()->vehicles.end())
 			{
-				boost::unordered_map<int, Item::SharedVehicle>::iterator p = core->getData()->vehicles.find(i->first);
-				if (p != core->getData()->vehicles.end())
+				if (!Utility::isInContainer(p->second->carmods, componentid))
 				{
-					if (!Utility::isInContainer(p->second->carmods, componentid))
-					{
-						Utility::addToContainer(p->second->carmods, componentid);
-					}
+					Utility::addToContainer(p->second->carmods, componentid);
 				}
 			}
-			break;
 		}
 	}
 	return retVal;
@@ -558,27 +536,24 @@ PLUGIN_EXPORT bool PLUGIN_CALL OnVehicleMod(int playerid, int vehicleid, int com
 
 PLUGIN_EXPORT bool PLUGIN_CALL OnVehiclePaintjob(int playerid, int vehicleid, int paintjobid)
 {
-	for (boost::unordered_map<int, int>::iterator i = core->getData()->internalVehicles.begin(); i != core->getData()->internalVehicles.end(); ++i)
+	boost::unordered_map<int, int>::iterator i = core->getData()->internalVehicles.find(core->getData()->reverseVehicles.find(vehicleid));
+	if (i != core->getData()->internalVehicles.end())
 	{
-		if (i->second == vehicleid)
+		for (std::set<AMX*>::iterator a = core->getData()->interfaces.begin(); a != core->getData()->interfaces.end(); ++a)
 		{
-			for (std::set<AMX*>::iterator a = core->getData()->interfaces.begin(); a != core->getData()->interfaces.end(); ++a)
+			int amxIndex = 0;
+			if (Utility::findPublic(*a, STREAMER_CALLBACK_ON_DYNAMIC_VEHICLE_PAINTJOB, amxIndex))
 			{
-				int amxIndex = 0;
-				if (!amx_FindPublic(*a, "OnDynamicVehiclePaintjob", &amxIndex))
-				{
-					amx_Push(*a, static_cast<cell>(paintjobid));
-					amx_Push(*a, static_cast<cell>(i->first));
-					amx_Push(*a, static_cast<cell>(playerid));
-					amx_Exec(*a, NULL, amxIndex);
-				}
+				amx_Push(*a, static_cast<cell>(paintjobid));
+				amx_Push(*a, static_cast<cell>(i->first));
+				amx_Push(*a, static_cast<cell>(playerid));
+				amx_Exec(*a, NULL, amxIndex);
 			}
-			boost::unordered_map<int, Item::SharedVehicle>::iterator p = core->getData()->vehicles.find(i->first);
-			if (p != core->getData()->vehicles.end())
-			{
-				p->second->paintjob = paintjobid;
-			}
-			break;
+		}
+		boost::unordered_map<int, Item::SharedVehicle>::iterator p = core->getData()->vehicles.find(i->first);
+		if (p != core->getData()->vehicles.end())
+		{
+			p->second->paintjob = paintjobid;
 		}
 	}
 	return true;
@@ -587,37 +562,34 @@ PLUGIN_EXPORT bool PLUGIN_CALL OnVehiclePaintjob(int playerid, int vehicleid, in
 PLUGIN_EXPORT bool PLUGIN_CALL OnVehicleRespray(int playerid, int vehicleid, int color1, int color2)
 {
 	bool retVal = true;
-	for (boost::unordered_map<int, int>::iterator i = core->getData()->internalVehicles.begin(); i != core->getData()->internalVehicles.end(); ++i)
+	boost::unordered_map<int, int>::iterator i = core->getData()->internalVehicles.find(core->getData()->reverseVehicles.find(vehicleid));
+	if (i != core->getData()->internalVehicles.end())
 	{
-		if (i->second == vehicleid)
+		for (std::set<AMX*>::iterator a = core->getData()->interfaces.begin(); a != core->getData()->interfaces.end(); ++a)
 		{
-			for (std::set<AMX*>::iterator a = core->getData()->interfaces.begin(); a != core->getData()->interfaces.end(); ++a)
-			{
-				int amxIndex = 0;
-				cell amxRetVal = 1;
-				if (!amx_FindPublic(*a, "OnDynamicVehicleRespray", &amxIndex))
+			int amxIndex = 0;
+			cell amxRetVal = 1;
+			if (Utility::findPublic(*a, STREAMER_CALLBACK_ON_DYNAMIC_VEHICLE_RESPRAY, amxIndex))
+			{
+				amx_Push(*a, static_cast<cell>(color2));
+				amx_Push(*a, static_cast<cell>(color1));
+				amx_Push(*a, static_cast<cell>(i->first));
+				amx_Push(*a, static_cast<cell>(playerid));
+				amx_Exec(*a, &amxRetVal, amxIndex);
+				if (amxRetVal == 0)
 				{
-					amx_Push(*a, static_cast<cell>(color2));
-					amx_Push(*a, static_cast<cell>(color1));
-					amx_Push(*a, static_cast<cell>(i->first));
-					amx_Push(*a, static_cast<cell>(playerid));
-					amx_Exec(*a, &amxRetVal, amxIndex);
-					if (amxRetVal == 0)
-					{
-						retVal = false;
-					}
+					retVal = false;
 				}
 			}
-			if(retVal)
+		}
+		if(retVal)
+		{
+			boost::unordered_map<int, Item::SharedVehicle>::iterator p = core->getData()->vehicles.find(i->first);
+			if (p != core->getData()->vehicles.end())
 			{
-				boost::unordered_map<int, Item::SharedVehicle>::iterator p = core->getData()->vehicles.find(i->first);
-				if (p != core->getData()->vehicles.end())
-				{
-					p->second->color[0] = color1;
-					p->second->color[1] = color2;
-				}
+				p->second->color[0] = color1;
+				p->second->color[1] = color2;
 			}
-			break;
 		}
 	}
 	return retVal;
@@ -625,32 +597,30 @@ PLUGIN_EXPORT bool PLUGIN_CALL OnVehicleRespray(int playerid, int vehicleid, int
 
 PLUGIN_EXPORT bool PLUGIN_CALL OnVehicleDamageStatusUpdate(int vehicleid, int playerid)
 {
-	for (boost::unordered_map<int, int>::iterator i = core->getData()->internalVehicles.begin(); i != core->getData()->internalVehicles.end(); ++i)
+	boost::unordered_map<int, int>::iterator i = core->getData()->internalVehicles.find(core->getData()->reverseVehicles.find(vehicleid));
+	if (i != core->getData()->internalVehicles.end())
 	{
-		if (i->second == vehicleid)
+		for (std::set<AMX*>::iterator a = core->getData()->interfaces.begin(); a != core->getData()->interfaces.end(); ++a)
 		{
-			for (std::set<AMX*>::iterator a = core->getData()->interfaces.begin(); a != core->getData()->interfaces.end(); ++a)
+			int amxIndex = 0;
+			if (Utility::findPublic(*a, STREAMER_CALLBACK_ON_DYNAMIC_VEH_DAMAGE_STATUS_UPDATE, amxIndex))
 			{
-				int amxIndex = 0;
-				if (!amx_FindPublic(*a, "OnDynamicVehDamageStatusUpdate", &amxIndex))
-				{
-					amx_Push(*a, static_cast<cell>(playerid));
-					amx_Push(*a, static_cast<cell>(i->first));
-					amx_Exec(*a, NULL, amxIndex);
-				}
+				amx_Push(*a, static_cast<cell>(playerid));
+				amx_Push(*a, static_cast<cell>(i->first));
+				amx_Exec(*a, NULL, amxIndex);
 			}
-			boost::unordered_map<int, Item::SharedVehicle>::iterator p = core->getData()->vehicles.find(i->first);
-			if (p != core->getData()->vehicles.end())
+		}
+		boost::unordered_map<int, Item::SharedVehicle>::iterator p = core->getData()->vehicles.find(i->first);
+		if (p != core->getData()->vehicles.end())
+		{
+			if (!p->second->touched)
 			{
-				if (!p->second->touched)
-				{
-					p->second->touched = true;
-				}
-				
-				//p->second->lastUpdatedTime = boost::chrono::steady_clock::now();
-				sampgdk::GetVehicleDamageStatus(i->second, &p->second->panels, &p->second->doors, &p->second->lights, &p->second->tires);
+				p->second->touched = true;
+				core->getStreamer()->scheduleVehicleRespawn(p->second);
 			}
-			break;
+			
+			//p->second->lastUpdatedTime = boost::chrono::steady_clock::now();
+			sampgdk::GetVehicleDamageStatus(i->second, &p->second->panels, &p->second->doors, &p->second->lights, &p->second->tires);
 		}
 	}
 	return true;
@@ -659,53 +629,51 @@ PLUGIN_EXPORT bool PLUGIN_CALL OnVehicleDamageStatusUpdate(int vehicleid, int pl
 PLUGIN_EXPORT bool PLUGIN_CALL OnUnoccupiedVehicleUpdate(int vehicleid, int playerid, int passenger_seat, float new_x, float new_y, float new_z, float vel_x, float vel_y, float vel_z)
 {
 	bool retVal = true;
-	for (boost::unordered_map<int, int>::iterator i = core->getData()->internalVehicles.begin(); i != core->getData()->internalVehicles.end(); ++i)
+	boost::unordered_map<int, int>::iterator i = core->getData()->internalVehicles.find(core->getData()->reverseVehicles.find(vehicleid));
+	if (i != core->getData()->internalVehicles.end())
 	{
-		if (i->second == vehicleid)
+		for (std::set<AMX*>::iterator a = core->getData()->interfaces.begin(); a != core->getData()->interfaces.end(); ++a)
 		{
-			for (std::set<AMX*>::iterator a = core->getData()->interfaces.begin(); a != core->getData()->interfaces.end(); ++a)
-			{
-				int amxIndex = 0;
-				cell amxRetVal = 1;
-				if (!amx_FindPublic(*a, "OnUnoccupiedDynamicVehUpdate", &amxIndex))
+			int amxIndex = 0;
+			cell amxRetVal = 1;
+			if (Utility::findPublic(*a, STREAMER_CALLBACK_ON_UNOCCUPIED_DYNAMIC_VEH_UPDATE, amxIndex))
+			{
+				amx_Push(*a, amx_ftoc(vel_z));
+				amx_Push(*a, amx_ftoc(vel_y));
+				amx_Push(*a, amx_ftoc(vel_x));
+				amx_Push(*a, amx_ftoc(new_z));
+				amx_Push(*a, amx_ftoc(new_y));
+				amx_Push(*a, amx_ftoc(new_x));
+				amx_Push(*a, static_cast<cell>(passenger_seat));
+				amx_Push(*a, static_cast<cell>(playerid));
+				amx_Push(*a, static_cast<cell>(i->first));
+				amx_Exec(*a, &amxRetVal, amxIndex);
+				if (amxRetVal == 0)
 				{
-					amx_Push(*a, amx_ftoc(vel_z));
-					amx_Push(*a, amx_ftoc(vel_y));
-					amx_Push(*a, amx_ftoc(vel_x));
-					amx_Push(*a, amx_ftoc(new_z));
-					amx_Push(*a, amx_ftoc(new_y));
-					amx_Push(*a, amx_ftoc(new_x));
-					amx_Push(*a, static_cast<cell>(passenger_seat));
-					amx_Push(*a, static_cast<cell>(playerid));
-					amx_Push(*a, static_cast<cell>(i->first));
-					amx_Exec(*a, &amxRetVal, amxIndex);
-					if (amxRetVal == 0)
-					{
-						retVal = false;
-					}
+					retVal = false;
 				}
 			}
-			if (retVal)
+		}
+		if (retVal)
+		{
+			boost::unordered_map<int, Item::SharedVehicle>::iterator p = core->getData()->vehicles.find(i->first);
+			if (p != core->getData()->vehicles.end())
 			{
-				boost::unordered_map<int, Item::SharedVehicle>::iterator p = core->getData()->vehicles.find(i->first);
-				if (p != core->getData()->vehicles.end())
+				if (!p->second->touched)
 				{
-					if (!p->second->touched)
-					{
-						p->second->touched = true;
-					}
-					p->second->position = Eigen::Vector3f(new_x, new_y, new_z);
-					sampgdk::GetVehicleZAngle(i->second, &p->second->angle);
-					sampgdk::GetVehicleHealth(i->second, &p->second->health);
-					sampgdk::GetVehicleRotationQuat(i->second, &p->second->quat[0], &p->second->quat[1], &p->second->quat[2], &p->second->quat[3]);
-					p->second->lastUpdatedTime = boost::chrono::steady_clock::now();
-					if (p->second->cell)
-					{
-						core->getGrid()->removeVehicle(p->second, true);
-					}
+					p->second->touched = true;
+					core->getStreamer()->scheduleVehicleRespawn(p->second);
+				}
+				p->second->position = Eigen::Vector3f(new_x, new_y, new_z);
+				sampgdk::GetVehicleZAngle(i->second, &p->second->angle);
+				sampgdk::GetVehicleHealth(i->second, &p->second->health);
+				sampgdk::GetVehicleRotationQuat(i->second, &p->second->quat[0], &p->second->quat[1], &p->second->quat[2], &p->second->quat[3]);
+				p->second->lastUpdatedTime = boost::chrono::steady_clock::now();
+				if (p->second->cell)
+				{
+					core->getGrid()->removeVehicle(p->second, true);
 				}
 			}
-			break;
 		}
 	}
 	return retVal;
@@ -714,47 +682,45 @@ PLUGIN_EXPORT bool PLUGIN_CALL OnUnoccupiedVehicleUpdate(int vehicleid, int play
 PLUGIN_EXPORT bool PLUGIN_CALL OnTrailerUpdate(int playerid, int vehicleid)
 {
 	bool retVal = true;
-	for (boost::unordered_map<int, int>::iterator i = core->getData()->internalVehicles.begin(); i != core->getData()->internalVehicles.end(); ++i)
+	boost::unordered_map<int, int>::iterator i = core->getData()->internalVehicles.find(core->getData()->reverseVehicles.find(vehicleid));
+	if (i != core->getData()->internalVehicles.end())
 	{
-		if (i->second == vehicleid)
+		for (std::set<AMX*>::iterator a = core->getData()->interfaces.begin(); a != core->getData()->interfaces.end(); ++a)
 		{
-			for (std::set<AMX*>::iterator a = core->getData()->interfaces.begin(); a != core->getData()->interfaces.end(); ++a)
-			{
-				int amxIndex = 0;
-				cell amxRetVal = 1;
-				if (!amx_FindPublic(*a, "OnDynamicTrailerUpdate", &amxIndex))
+			int amxIndex = 0;
+			cell amxRetVal = 1;
+			if (Utility::findPublic(*a, STREAMER_CALLBACK_ON_DYNAMIC_TRAILER_UPDATE, amxIndex))
+			{
+				amx_Push(*a, static_cast<cell>(i->first));
+				amx_Push(*a, static_cast<cell>(playerid));
+				amx_Exec(*a, &amxRetVal, amxIndex);
+				if (amxRetVal == 0)
 				{
-					amx_Push(*a, static_cast<cell>(i->first));
-					amx_Push(*a, static_cast<cell>(playerid));
-					amx_Exec(*a, &amxRetVal, amxIndex);
-					if (amxRetVal == 0)
-					{
-						retVal = false;
-					}
+					retVal = false;
 				}
 			}
-			if(retVal)
+		}
+		if(retVal)
+		{
+			boost::unordered_map<int, Item::SharedVehicle>::iterator p = core->getData()->vehicles.find(i->first);
+			if (p != core->getData()->vehicles.end())
 			{
-				boost::unordered_map<int, Item::SharedVehicle>::iterator p = core->getData()->vehicles.find(i->first);
-				if (p != core->getData()->vehicles.end())
+				if (!p->second->touched)
 				{
-					if (!p->second->touched)
-					{
-						p->second->touched = true;
-					}
-					sampgdk::GetVehiclePos(i->second, &p->second->position[0], &p->second->position[1], &p->second->position[2]);
-					sampgdk::GetVehicleZAngle(i->second, &p->second->angle);
-					sampgdk::GetVehicleHealth(i->second, &p->second->health);
-					sampgdk::GetVehicleRotationQuat(i->second, &p->second->quat[0], &p->second->quat[1], &p->second->quat[2], &p->second->quat[3]);
-					p->second->lastUpdatedTime = boost::chrono::steady_clock::now();
+					p->second->touched = true;
+					core->getStreamer()->scheduleVehicleRespawn(p->second);
+				}
+				sampgdk::GetVehiclePos(i->second, &p->second->position[0], &p->second->position[1], &p->second->position[2]);
+				sampgdk::GetVehicleZAngle(i->second, &p->second->angle);
+				sampgdk::GetVehicleHealth(i->second, &p->second->health);
+				sampgdk::GetVehicleRotationQuat(i->second, &p->second->quat[0], &p->second->quat[1], &p->second->quat[2], &p->second->quat[3]);
+				p->second->lastUpdatedTime = boost::chrono::steady_clock::now();
 
-					if (p->second->cell)
-					{
-						core->getGrid()->removeVehicle(p->second, true);
-					}
+				if (p->second->cell)
+				{
+					core->getGrid()->removeVehicle(p->second, true);
 				}
 			}
-			break;
 		}
 	}
 	return retVal;
@@ -762,21 +728,18 @@ PLUGIN_EXPORT bool PLUGIN_CALL OnTrailerUpdate(int playerid, int vehicleid)
 
 PLUGIN_EXPORT bool PLUGIN_CALL OnVehicleStreamIn(int vehicleid, int forplayerid)
 {
-	for (boost::unordered_map<int, int>::iterator i = core->getData()->internalVehicles.begin(); i != core->getData()->internalVehicles.end(); ++i)
+	boost::unordered_map<int, int>::iterator i = core->getData()->internalVehicles.find(core->getData()->reverseVehicles.find(vehicleid));
+	if (i != core->getData()->internalVehicles.end())
 	{
-		if (i->second == vehicleid)
+		for (std::set<AMX*>::iterator a = core->getData()->interfaces.begin(); a != core->getData()->interfaces.end(); ++a)
 		{
-			for (std::set<AMX*>::iterator a = core->getData()->interfaces.begin(); a != core->getData()->interfaces.end(); ++a)
+			int amxIndex = 0;
+			if (Utility::findPublic(*a, STREAMER_CALLBACK_ON_DYNAMIC_VEHICLE_STREAM_IN, amxIndex))
 			{
-				int amxIndex = 0;
-				if (!amx_FindPublic(*a, "OnDynamicVehicleStreamIn", &amxIndex))
-				{
-					amx_Push(*a, static_cast<cell>(forplayerid));
-					amx_Push(*a, static_cast<cell>(i->first));
-					amx_Exec(*a, NULL, amxIndex);
-				}
+				amx_Push(*a, static_cast<cell>(forplayerid));
+				amx_Push(*a, static_cast<cell>(i->first));
+				amx_Exec(*a, NULL, amxIndex);
 			}
-			break;
 		}
 	}
 	return true;
@@ -784,21 +747,18 @@ PLUGIN_EXPORT bool PLUGIN_CALL OnVehicleStreamIn(int vehicleid, int forplayerid)
 
 PLUGIN_EXPORT bool PLUGIN_CALL OnVehicleStreamOut(int vehicleid, int forplayerid)
 {
-	for (boost::unordered_map<int, int>::iterator i = core->getData()->internalVehicles.begin(); i != core->getData()->internalVehicles.end(); ++i)
+	boost::unordered_map<int, int>::iterator i = core->getData()->internalVehicles.find(core->getData()->reverseVehicles.find(vehicleid));
+	if (i != core->getData()->internalVehicles.end())
 	{
-		if (i->second == vehicleid)
+		for (std::set<AMX*>::iterator a = core->getData()->interfaces.begin(); a != core->getData()->interfaces.end(); ++a)
 		{
-			for (std::set<AMX*>::iterator a = core->getData()->interfaces.begin(); a != core->getData()->interfaces.end(); ++a)
+			int amxIndex = 0;
+			if (Utility::findPublic(*a, STREAMER_CALLBACK_ON_DYNAMIC_VEHICLE_STREAM_OUT, amxIndex))
 			{
-				int amxIndex = 0;
-				if (!amx_FindPublic(*a, "OnDynamicVehicleStreamOut", &amxIndex))
-				{
-					amx_Push(*a, static_cast<cell>(forplayerid));
-					amx_Push(*a, static_cast<cell>(i->first));
-					amx_Exec(*a, NULL, amxIndex);
-				}
+				amx_Push(*a, static_cast<cell>(forplayerid));
+				amx_Push(*a, static_cast<cell>(i->first));
+				amx_Exec(*a, NULL, amxIndex);
 			}
-			break;
 		}
 	}
 	return true;
@@ -806,27 +766,24 @@ PLUGIN_EXPORT bool PLUGIN_CALL OnVehicleStreamOut(int vehicleid, int forplayerid
 
 PLUGIN_EXPORT bool PLUGIN_CALL OnVehicleSirenStateChange(int playerid, int vehicleid, int newstate)
 {
-	for (boost::unordered_map<int, int>::iterator i = core->getData()->internalVehicles.begin(); i != core->getData()->internalVehicles.end(); ++i)
+	boost::unordered_map<int, int>::iterator i = core->getData()->internalVehicles.find(core->getData()->reverseVehicles.find(vehicleid));
+	if (i != core->getData()->internalVehicles.end())
 	{
-		if (i->second == vehicleid)
+		for (std::set<AMX*>::iterator a = core->getData()->interfaces.begin(); a != core->getData()->interfaces.end(); ++a)
 		{
-			for (std::set<AMX*>::iterator a = core->getData()->interfaces.begin(); a != core->getData()->interfaces.end(); ++a)
-			{
-				int amxIndex = 0;
-				if (!amx_FindPublic(*a, "OnDynamicVehSirenStateChange", &amxIndex))
-				{
-					amx_Push(*a, static_cast<cell>(newstate));
-					amx_Push(*a, static_cast<cell>(i->first));
-					amx_Push(*a, static_cast<cell>(playerid));
-					amx_Exec(*a, NULL, amxIndex);
-				}
-			}
-			boost::unordered_map<int, Item::SharedVehicle>::iterator p = core->getData()->vehicles.find(i->first);
-			if (p != core->getData()->vehicles.end())
+			int amxIndex = 0;
+			if (Utility::findPublic(*a, STREAMER_CALLBACK_ON_DYNAMIC_VEH_SIREN_STATE_CHANGE, amxIndex))
 			{
-				p->second->params.siren = static_cast<char>(newstate);
+				amx_Push(*a, static_cast<cell>(newstate));
+				amx_Push(*a, static_cast<cell>(i->first));
+				amx_Push(*a, static_cast<cell>(playerid));
+				amx_Exec(*a, NULL, amxIndex);
 			}
-			break;
+		}
+		boost::unordered_map<int, Item::SharedVehicle>::iterator p = core->getData()->vehicles.find(i->first);
+		if (p != core->getData()->vehicles.end())
+		{
+			p->second->params.siren = static_cast<char>(newstate);
 		}
 	}
 	return true;
@@ -18,5 +18,5 @@
 
 #include "common.h"
 
-Cell::Cell() : references(0) {}
-Cell::Cell(CellID cellID) : cellID(cellID), references(0) {}
+Cell::Cell() : level(-1), worldID(-1), references(0), version(0) {}
+Cell::Cell(CellID cellID, int level, int worldID) : cellID(cellID), level(level), worldID(worldID), references(0), version(0) {}
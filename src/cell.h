@@ -20,6 +20,7 @@
 #include "common.h"
 #include "item.h"
 
+#include <boost/cstdint.hpp>
 #include <boost/intrusive_ptr.hpp>
 #include <boost/unordered_map.hpp>
 
@@ -27,10 +28,13 @@ class Cell
 {
 public:
 	Cell();
-	Cell(CellID cellID);
+	Cell(CellID cellID, int level, int worldID);
 
 	CellID cellID;
+	int level;
+	int worldID;
 	int references;
+	std::size_t version;
 
 	boost::unordered_map<int, Item::SharedArea> areas;
 	boost::unordered_map<int, Item::SharedCheckpoint> checkpoints;
@@ -43,4 +47,29 @@ public:
 	boost::unordered_map<int, Item::SharedVehicle> vehicles;
 };
 
+inline boost::uint64_t getCellKey(const CellID &cellID)
+{
+	boost::uint64_t key[2] = { static_cast<boost::uint32_t>(cellID.first) ^ 0x80000000U, static_cast<boost::uint32_t>(cellID.second) ^ 0x80000000U };
+	for (std::size_t i = 0; i < 2; ++i)
+	{
+		key[i] = (key[i] | (key[i] << 16)) & 0x0000FFFF0000FFFFULL;
+		key[i] = (key[i] | (key[i] << 8)) & 0x00FF00FF00FF00FFULL;
+		key[i] = (key[i] | (key[i] << 4)) & 0x0F0F0F0F0F0F0F0FULL;
+		key[i] = (key[i] | (key[i] << 2)) & 0x3333333333333333ULL;
+		key[i] = (key[i] | (key[i] << 1)) & 0x5555555555555555ULL;
+	}
+	return key[0] | (key[1] << 1);
+}
+
+struct CellHash
+{
+	inline std::size_t operator()(const CellID &cellID) const
+	{
+		boost::uint64_t key = getCellKey(cellID);
+		return static_cast<std::size_t>(key ^ (key >> 32));
+	}
+};
+
+typedef boost::unordered_map<CellID, SharedCell, CellHash> CellMap;
+
 #endif
@@ -50,6 +50,67 @@
 
 #define STREAMER_STATIC_DISTANCE_CUTOFF (0.0f)
 
+#define STREAMER_GRID_BOUNDS (4000.0f)
+#define STREAMER_GRID_LEVELS (4)
+#define STREAMER_GRID_MAX_DENSE_CELLS (512)
+#define STREAMER_GRID_REBUILD_CHUNK_SIZE (4096)
+
+#define STREAMER_MAX_CALLBACKS (35)
+
+#define STREAMER_CALLBACK_ON_DYNAMIC_ACTOR_STREAM_IN (0)
+#define STREAMER_CALLBACK_ON_DYNAMIC_ACTOR_STREAM_OUT (1)
+#define STREAMER_CALLBACK_ON_DYNAMIC_OBJECT_MOVED (2)
+#define STREAMER_CALLBACK_ON_DYNAMIC_TRAILER_UPDATE (3)
+#define STREAMER_CALLBACK_ON_DYNAMIC_VEH_DAMAGE_STATUS_UPDATE (4)
+#define STREAMER_CALLBACK_ON_DYNAMIC_VEH_SIREN_STATE_CHANGE (5)
+#define STREAMER_CALLBACK_ON_DYNAMIC_VEHICLE_DEATH (6)
+#define STREAMER_CALLBACK_ON_DYNAMIC_VEHICLE_MOD (7)
+#define STREAMER_CALLBACK_ON_DYNAMIC_VEHICLE_PAINTJOB (8)
+#define STREAMER_CALLBACK_ON_DYNAMIC_VEHICLE_RESPRAY (9)
+#define STREAMER_CALLBACK_ON_DYNAMIC_VEHICLE_SPAWN (10)
+#define STREAMER_CALLBACK_ON_DYNAMIC_VEHICLE_STREAM_IN (11)
+#define STREAMER_CALLBACK_ON_DYNAMIC_VEHICLE_STREAM_OUT (12)
+#define STREAMER_CALLBACK_ON_PLAYER_EDIT_DYNAMIC_OBJECT (13)
+#define STREAMER_CALLBACK_ON_PLAYER_ENTER_DYNAMIC_AREA (14)
+#define STREAMER_CALLBACK_ON_PLAYER_ENTER_DYNAMIC_AREAS (15)
+#define STREAMER_CALLBACK_ON_PLAYER_ENTER_DYNAMIC_CP (16)
+#define STREAMER_CALLBACK_ON_PLAYER_ENTER_DYNAMIC_RACE_CP (17)
+#define STREAMER_CALLBACK_ON_PLAYER_ENTER_DYNAMIC_VEHICLE (18)
+#define STREAMER_CALLBACK_ON_PLAYER_EXIT_DYNAMIC_VEHICLE (19)
+#define STREAMER_CALLBACK_ON_PLAYER_GIVE_DAMAGE_DYNAMIC_ACTOR (20)
+#define STREAMER_CALLBACK_ON_PLAYER_LEAVE_DYNAMIC_AREA (21)
+#define STREAMER_CALLBACK_ON_PLAYER_LEAVE_DYNAMIC_AREAS (22)
+#define STREAMER_CALLBACK_ON_PLAYER_LEAVE_DYNAMIC_CP (23)
+#define STREAMER_CALLBACK_ON_PLAYER_LEAVE_DYNAMIC_RACE_CP (24)
+#define STREAMER_CALLBACK_ON_PLAYER_PICK_UP_DYNAMIC_PICKUP (25)
+#define STREAMER_CALLBACK_ON_PLAYER_SELECT_DYNAMIC_OBJECT (26)
+#define STREAMER_CALLBACK_ON_PLAYER_SHOOT_DYNAMIC_OBJECT (27)
+#define STREAMER_CALLBACK_ON_PLAYER_SHOOT_DYNAMIC_VEHICLE (28)
+#define STREAMER_CALLBACK_ON_UNOCCUPIED_DYNAMIC_VEH_UPDATE (29)
+#define STREAMER_CALLBACK_ON_ITEM_STREAM_IN (30)
+#define STREAMER_CALLBACK_ON_ITEM_STREAM_OUT (31)
+#define STREAMER_CALLBACK_ON_ITEMS_STREAM_IN (32)
+#define STREAMER_CALLBACK_ON_ITEMS_STREAM_OUT (33)
+#define STREAMER_CALLBACK_ON_PLUGIN_ERROR (34)
+
+#define STREAMER_MAX_NATIVES (3)
+
+#define STREAMER_NATIVE_ATTACH_PLAYER_OBJECT_TO_OBJECT (0)
+#define STREAMER_NATIVE_ATTACH_PLAYER_OBJECT_TO_PLAYER (1)
+#define STREAMER_NATIVE_SET_PLAYER_GRAVITY (2)
+
+#define STREAMER_COST_CREATE_OBJECT (48)
+#define STREAMER_COST_DESTROY_OBJECT (12)
+#define STREAMER_COST_ATTACH_OBJECT (40)
+#define STREAMER_COST_MOVE_OBJECT (44)
+#define STREAMER_COST_OBJECT_MATERIAL (24)
+#define STREAMER_COST_OBJECT_MATERIAL_TEXT (32)
+#define STREAMER_COST_OBJECT_NO_CAMERA_COL (12)
+#define STREAMER_COST_SET_MAP_ICON (28)
+#define STREAMER_COST_REMOVE_MAP_ICON (12)
+#define STREAMER_COST_CREATE_3D_TEXT_LABEL (40)
+#define STREAMER_COST_DELETE_3D_TEXT_LABEL (12)
+
 #define STREAMER_VEHICLE_TYPE_STATIC (0)
 #define STREAMER_VEHICLE_TYPE_DYNAMIC (1)
 
@@ -132,6 +193,12 @@ namespace Item
 			}
 			return a.second < b.second;
 		}
+
+		template<typename T>
+		bool operator()(std::pair<std::pair<int, float>, T> const &a, std::pair<std::pair<int, float>, T> const &b)
+		{
+			return operator()(a.first, b.first);
+		}
 	};
 }
 
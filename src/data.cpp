@@ -20,7 +20,15 @@
 
 Data::Data()
 {
+	conditionVersion = 0;
 	errorCallbackEnabled = false;
+	for (int i = 0; i < STREAMER_MAX_NATIVES; ++i)
+	{
+		natives[i] = NULL;
+	}
+	globalChunkByteBudget[STREAMER_TYPE_OBJECT] = 0;
+	globalChunkByteBudget[STREAMER_TYPE_MAP_ICON] = 0;
+	globalChunkByteBudget[STREAMER_TYPE_3D_TEXT_LABEL] = 0;
 	globalChunkTickRate[STREAMER_TYPE_OBJECT] = 1;
 	globalChunkTickRate[STREAMER_TYPE_MAP_ICON] = 1;
 	globalChunkTickRate[STREAMER_TYPE_3D_TEXT_LABEL] = 1;
@@ -66,6 +74,25 @@ Data::Data()
 	}
 }
 
+std::size_t Data::getGlobalChunkByteBudget(int type)
+{
+	if (type >= 0 && type < STREAMER_MAX_TYPES)
+	{
+		return globalChunkByteBudget[type];
+	}
+	return 0;
+}
+
+bool Data::setGlobalChunkByteBudget(int type, std::size_t value)
+{
+	if (type >= 0 && type < STREAMER_MAX_TYPES)
+	{
+		globalChunkByteBudget[type] = value;
+		return true;
+	}
+	return false;
+}
+
 std::size_t Data::getGlobalChunkTickRate(int type)
 {
 	if (type >= 0 && type < STREAMER_MAX_TYPES)
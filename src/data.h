@@ -33,6 +33,9 @@ public:
 	std::size_t getGlobalChunkTickRate(int type);
 	bool setGlobalChunkTickRate(int type, std::size_t value);
 
+	std::size_t getGlobalChunkByteBudget(int type);
+	bool setGlobalChunkByteBudget(int type, std::size_t value);
+
 	std::size_t getGlobalMaxItems(int type);
 	bool setGlobalMaxItems(int type, std::size_t value);
 
@@ -42,9 +45,12 @@ public:
 	float getGlobalRadiusMultiplier(int type);
 	bool setGlobalRadiusMultiplier(int type, float value);
 
+	std::size_t conditionVersion;
 	bool errorCallbackEnabled;
 
 	std::set<AMX*> interfaces;
+	boost::unordered_map<AMX*, std::vector<int> > interfaceCallbacks;
+	AMX_NATIVE natives[STREAMER_MAX_NATIVES];
 
 	std::vector<int> destroyedActors;
 
@@ -56,6 +62,21 @@ public:
 	boost::unordered_map<int, int> internalPickups;
 	boost::unordered_map<int, int> internalVehicles;
 
+	ReverseIndex reverseActors;
+	ReverseIndex reversePickups;
+	ReverseIndex reverseVehicles;
+
+	boost::unordered_map<int, int> vehicleDrivers;
+	std::vector<int> drivenVehicles;
+
+	boost::unordered_map<int, std::size_t> actorReferences;
+	boost::unordered_map<int, std::size_t> pickupReferences;
+	boost::unordered_map<int, std::size_t> vehicleReferences;
+
+	std::vector<int> releasedActors;
+	std::vector<int> releasedPickups;
+	std::vector<int> releasedVehicles;
+
 	boost::unordered_map<int, Item::SharedActor> actors;
 	boost::unordered_map<int, Item::SharedArea> areas;
 	boost::unordered_map<int, Item::SharedCheckpoint> checkpoints;
@@ -70,6 +91,7 @@ public:
 
 	std::vector<int> typePriority;
 private:
+	std::size_t globalChunkByteBudget[STREAMER_MAX_TYPES];
 	std::size_t globalChunkTickRate[STREAMER_MAX_TYPES];
 	std::size_t globalMaxItems[STREAMER_MAX_TYPES];
 	std::size_t globalMaxVisibleItems[STREAMER_MAX_TYPES];
@@ -29,6 +29,7 @@
 #include <Eigen/Core>
 
 #include <cmath>
+#include <limits>
 #include <vector>
 
 Grid::Grid()
@@ -36,29 +37,35 @@ Grid::Grid()
 	cellDistance = 360000.0f;
 	cellSize = 300.0f;
 	globalCell = SharedCell(new Cell());
-	calculateTranslationMatrix();
+	calculateLevels();
 }
 
 void Grid::addActor(const Item::SharedActor &actor)
 {
-	if (actor->comparableStreamDistance > cellDistance || actor->comparableStreamDistance < STREAMER_STATIC_DISTANCE_CUTOFF)
+	int level = findLevel(actor->comparableStreamDistance);
+	if (level < 0)
 	{
 		globalCell->actors.insert(std::make_pair(actor->actorID, actor));
+		++globalCell->version;
 		actor->cell.reset();
 	}
 	else
 	{
-		CellID cellID = getCellID(Eigen::Vector2f(actor->position[0], actor->position[1]));
-		cells[cellID]->actors.insert(std::make_pair(actor->actorID, actor));
-		actor->cell = cells[cellID];
+		SharedCell cell = getCell(level, getWorldPartition(actor->worlds), Eigen::Vector2f(actor->position[0], actor->position[1]));
+		cell->actors.insert(std::make_pair(actor->actorID, actor));
+		++cell->version;
+		actor->cell = cell;
 	}
 }
 
 void Grid::addArea(const Item::SharedArea &area)
 {
-	if (area->comparableSize > cellDistance)
+	indexArea(area);
+	int level = findLevel(area->comparableSize);
+	if (level < 0)
 	{
 		globalCell->areas.insert(std::make_pair(area->areaID, area));
+		++globalCell->version;
 		area->cell.reset();
 	}
 	else
@@ -103,47 +110,56 @@ void Grid::addArea(const Item::SharedArea &area)
 				break;
 			}
 		}
-		CellID cellID = getCellID(centroid);
-		cells[cellID]->areas.insert(std::make_pair(area->areaID, area));
-		area->cell = cells[cellID];
+		SharedCell cell = getCell(level, getWorldPartition(area->worlds), centroid);
+		cell->areas.insert(std::make_pair(area->areaID, area));
+		++cell->version;
+		area->cell = cell;
 	}
 }
 
 void Grid::addCheckpoint(const Item::SharedCheckpoint &checkpoint)
 {
-	if (checkpoint->comparableStreamDistance > cellDistance || checkpoint->comparableStreamDistance < STREAMER_STATIC_DISTANCE_CUTOFF)
+	int level = findLevel(checkpoint->comparableStreamDistance);
+	if (level < 0)
 	{
 		globalCell->checkpoints.insert(std::make_pair(checkpoint->checkpointID, checkpoint));
+		++globalCell->version;
 		checkpoint->cell.reset();
 	}
 	else
 	{
-		CellID cellID = getCellID(Eigen::Vector2f(checkpoint->position[0], checkpoint->position[1]));
-		cells[cellID]->checkpoints.insert(std::make_pair(checkpoint->checkpointID, checkpoint));
-		checkpoint->cell = cells[cellID];
+		SharedCell cell = getCell(level, getWorldPartition(checkpoint->worlds), Eigen::Vector2f(checkpoint->position[0], checkpoint->position[1]));
+		cell->checkpoints.insert(std::make_pair(checkpoint->checkpointID, checkpoint));
+		++cell->version;
+		checkpoint->cell = cell;
 	}
 }
 
 void Grid::addMapIcon(const Item::SharedMapIcon &mapIcon)
 {
-	if (mapIcon->comparableStreamDistance > cellDistance || mapIcon->comparableStreamDistance < STREAMER_STATIC_DISTANCE_CUTOFF)
+	int level = findLevel(mapIcon->comparableStreamDistance);
+	if (level < 0)
 	{
 		globalCell->mapIcons.insert(std::make_pair(mapIcon->mapIconID, mapIcon));
+		++globalCell->version;
 		mapIcon->cell.reset();
 	}
 	else
 	{
-		CellID cellID = getCellID(Eigen::Vector2f(mapIcon->position[0], mapIcon->position[1]));
-		cells[cellID]->mapIcons.insert(std::make_pair(mapIcon->mapIconID, mapIcon));
-		mapIcon->cell = cells[cellID];
+		SharedCell cell = getCell(level, getWorldPartition(mapIcon->worlds), Eigen::Vector2f(mapIcon->position[0], mapIcon->position[1]));
+		cell->mapIcons.insert(std::make_pair(mapIcon->mapIconID, mapIcon));
+		++cell->version;
+		mapIcon->cell = cell;
 	}
 }
 
 void Grid::addObject(const Item::SharedObject &object)
 {
-	if (object->comparableStreamDistance > cellDistance || object->comparableStreamDistance < STREAMER_STATIC_DISTANCE_CUTOFF)
+	int level = findLevel(object->comparableStreamDistance);
+	if (level < 0)
 	{
 		globalCell->objects.insert(std::make_pair(object->objectID, object));
+		++globalCell->version;
 		object->cell.reset();
 	}
 	else
@@ -157,47 +173,64 @@ void Grid::addObject(const Item::SharedObject &object)
 		{
 			position = Eigen::Vector2f(object->position[0], object->position[1]);
 		}
-		CellID cellID = getCellID(Eigen::Vector2f(position[0], position[1]));
-		cells[cellID]->objects.insert(std::make_pair(object->objectID, object));
-		object->cell = cells[cellID];
+		SharedCell cell = getCell(level, getWorldPartition(object->worlds), position);
+		cell->objects.insert(std::make_pair(object->objectID, object));
+		++cell->version;
+		object->cell = cell;
+	}
+	if (object->attach)
+	{
+		object->attach->assigned = true;
+	}
+	if (object->move)
+	{
+		core->getStreamer()->scheduleObjectMove(object);
 	}
 }
 
 void Grid::addPickup(const Item::SharedPickup &pickup)
 {
-	if (pickup->comparableStreamDistance > cellDistance || pickup->comparableStreamDistance < STREAMER_STATIC_DISTANCE_CUTOFF)
+	int level = findLevel(pickup->comparableStreamDistance);
+	if (level < 0)
 	{
 		globalCell->pickups.insert(std::make_pair(pickup->pickupID, pickup));
+		++globalCell->version;
 		pickup->cell.reset();
 	}
 	else
 	{
-		CellID cellID = getCellID(Eigen::Vector2f(pickup->position[0], pickup->position[1]));
-		cells[cellID]->pickups.insert(std::make_pair(pickup->pickupID, pickup));
-		pickup->cell = cells[cellID];
+		SharedCell cell = getCell(level, getWorldPartition(pickup->worlds), Eigen::Vector2f(pickup->position[0], pickup->position[1]));
+		cell->pickups.insert(std::make_pair(pickup->pickupID, pickup));
+		++cell->version;
+		pickup->cell = cell;
 	}
 }
 
 void Grid::addRaceCheckpoint(const Item::SharedRaceCheckpoint &raceCheckpoint)
 {
-	if (raceCheckpoint->comparableStreamDistance > cellDistance || raceCheckpoint->comparableStreamDistance < STREAMER_STATIC_DISTANCE_CUTOFF)
+	int level = findLevel(raceCheckpoint->comparableStreamDistance);
+	if (level < 0)
 	{
 		globalCell->raceCheckpoints.insert(std::make_pair(raceCheckpoint->raceCheckpointID, raceCheckpoint));
+		++globalCell->version;
 		raceCheckpoint->cell.reset();
 	}
 	else
 	{
-		CellID cellID = getCellID(Eigen::Vector2f(raceCheckpoint->position[0], raceCheckpoint->position[1]));
-		cells[cellID]->raceCheckpoints.insert(std::make_pair(raceCheckpoint->raceCheckpointID, raceCheckpoint));
-		raceCheckpoint->cell = cells[cellID];
+		SharedCell cell = getCell(level, getWorldPartition(raceCheckpoint->worlds), Eigen::Vector2f(raceCheckpoint->position[0], raceCheckpoint->position[1]));
+		cell->raceCheckpoints.insert(std::make_pair(raceCheckpoint->raceCheckpointID, raceCheckpoint));
+		++cell->version;
+		raceCheckpoint->cell = cell;
 	}
 }
 
 void Grid::addTextLabel(const Item::SharedTextLabel &textLabel)
 {
-	if (textLabel->comparableStreamDistance > cellDistance || textLabel->comparableStreamDistance < STREAMER_STATIC_DISTANCE_CUTOFF)
+	int level = findLevel(textLabel->comparableStreamDistance);
+	if (level < 0)
 	{
 		globalCell->textLabels.insert(std::make_pair(textLabel->textLabelID, textLabel));
+		++globalCell->version;
 		textLabel->cell.reset();
 	}
 	else
@@ -211,17 +244,24 @@ void Grid::addTextLabel(const Item::SharedTextLabel &textLabel)
 		{
 			position = Eigen::Vector2f(textLabel->position[0], textLabel->position[1]);;
 		}
-		CellID cellID = getCellID(position);
-		cells[cellID]->textLabels.insert(std::make_pair(textLabel->textLabelID, textLabel));
-		textLabel->cell = cells[cellID];
+		SharedCell cell = getCell(level, getWorldPartition(textLabel->worlds), position);
+		cell->textLabels.insert(std::make_pair(textLabel->textLabelID, textLabel));
+		++cell->version;
+		textLabel->cell = cell;
+	}
+	if (textLabel->attach)
+	{
+		textLabel->attach->assigned = true;
 	}
 }
 
 void Grid::addVehicle(const Item::SharedVehicle &vehicle)
 {
-	if (vehicle->comparableStreamDistance > cellDistance || vehicle->comparableStreamDistance < STREAMER_STATIC_DISTANCE_CUTOFF)
+	int level = findLevel(vehicle->comparableStreamDistance);
+	if (level < 0)
 	{
 		globalCell->vehicles.insert(std::make_pair(vehicle->vehicleID, vehicle));
+		++globalCell->version;
 		vehicle->cell.reset();
 
 		//sampgdk_logprintf("STREAMERDEBUG: addVehicle to global cell %d", vehicle->vehicleID);
@@ -230,53 +270,175 @@ void Grid::addVehicle(const Item::SharedVehicle &vehicle)
 	{
 		////sampgdk_logprintf("STREAMERDEBUG: Grid::addVehicle %d", vehicle->vehicleID);
 
-		CellID cellID = getCellID(Eigen::Vector2f(vehicle->position[0], vehicle->position[1]));
-		cells[cellID]->vehicles.insert(std::make_pair(vehicle->vehicleID, vehicle));
-		vehicle->cell = cells[cellID];
+		SharedCell cell = getCell(level, getWorldPartition(vehicle->worlds), Eigen::Vector2f(vehicle->position[0], vehicle->position[1]));
+		cell->vehicles.insert(std::make_pair(vehicle->vehicleID, vehicle));
+		++cell->version;
+		vehicle->cell = cell;
 	}
 }
 
 void Grid::rebuildGrid()
 {
-	cells.clear();
+	completeGridRebuild();
+	previousLevels.swap(levels);
+	previousGlobalCell = globalCell;
 	globalCell = SharedCell(new Cell());
-	calculateTranslationMatrix();
-	for (boost::unordered_map<int, Item::SharedActor>::iterator a = core->getData()->actors.begin(); a != core->getData()->actors.end(); ++a)
+	calculateLevels();
+	for (std::vector<Level>::iterator l = previousLevels.begin(); l != previousLevels.end(); ++l)
 	{
-		addActor(a->second);
+		for (std::vector<SharedCell>::iterator c = l->denseCells.begin(); c != l->denseCells.end(); ++c)
+		{
+			if (*c)
+			{
+				previousCells.push_back(*c);
+			}
+		}
+		for (CellMap::iterator c = l->cells.begin(); c != l->cells.end(); ++c)
+		{
+			previousCells.push_back(c->second);
+		}
+		for (boost::unordered_map<int, CellMap>::iterator w = l->worldCells.begin(); w != l->worldCells.end(); ++w)
+		{
+			for (CellMap::iterator c = w->second.begin(); c != w->second.end(); ++c)
+			{
+				previousCells.push_back(c->second);
+			}
+		}
 	}
-	for (boost::unordered_map<int, Item::SharedArea>::iterator a = core->getData()->areas.begin(); a != core->getData()->areas.end(); ++a)
+	previousCells.push_back(previousGlobalCell);
+	processGridRebuild(STREAMER_GRID_REBUILD_CHUNK_SIZE);
+}
+
+void Grid::processGridRebuild(std::size_t count)
+{
+	std::size_t migrated = 0;
+	while (!previousCells.empty() && migrated < count)
 	{
-		addArea(a->second);
+		SharedCell cell = previousCells.back();
+		migrated += migrateCell(cell, count - migrated);
+		if (migrated < count)
+		{
+			previousCells.pop_back();
+		}
 	}
-	for (boost::unordered_map<int, Item::SharedCheckpoint>::iterator c = core->getData()->checkpoints.begin(); c != core->getData()->checkpoints.end(); ++c)
+	if (previousCells.empty())
 	{
-		addCheckpoint(c->second);
+		previousLevels.clear();
+		previousGlobalCell.reset();
 	}
-	for (boost::unordered_map<int, Item::SharedMapIcon>::iterator m = core->getData()->mapIcons.begin(); m != core->getData()->mapIcons.end(); ++m)
+}
+
+void Grid::completeGridRebuild()
+{
+	if (isRebuildingGrid())
 	{
-		addMapIcon(m->second);
+		processGridRebuild(std::numeric_limits<std::size_t>::max());
 	}
-	for (boost::unordered_map<int, Item::SharedObject>::iterator o = core->getData()->objects.begin(); o != core->getData()->objects.end(); ++o)
+}
+
+std::size_t Grid::migrateCell(const SharedCell &cell, std::size_t count)
+{
+	std::size_t migrated = 0;
+	while (!cell->actors.empty() && migrated < count)
 	{
-		addObject(o->second);
+		Item::SharedActor actor = cell->actors.begin()->second;
+		removeActor(actor, true);
+		if (!cell->actors.empty() && cell->actors.begin()->second == actor)
+		{
+			cell->actors.quick_erase(cell->actors.begin());
+			++cell->version;
+		}
+		++migrated;
 	}
-	for (boost::unordered_map<int, Item::SharedPickup>::iterator p = core->getData()->pickups.begin(); p != core->getData()->pickups.end(); ++p)
+	while (!cell->areas.empty() && migrated < count)
 	{
-		addPickup(p->second);
+		Item::SharedArea area = cell->areas.begin()->second;
+		removeArea(area, true);
+		if (!cell->areas.empty() && cell->areas.begin()->second == area)
+		{
+			cell->areas.quick_erase(cell->areas.begin());
+			++cell->version;
+		}
+		++migrated;
 	}
-	for (boost::unordered_map<int, Item::SharedRaceCheckpoint>::iterator r = core->getData()->raceCheckpoints.begin(); r != core->getData()->raceCheckpoints.end(); ++r)
+	while (!cell->checkpoints.empty() && migrated < count)
 	{
-		addRaceCheckpoint(r->second);
+		Item::SharedCheckpoint checkpoint = cell->checkpoints.begin()->second;
+		removeCheckpoint(checkpoint, true);
+		if (!cell->checkpoints.empty() && cell->checkpoints.begin()->second == checkpoint)
+		{
+			cell->checkpoints.quick_erase(cell->checkpoints.begin());
+			++cell->version;
+		}
+		++migrated;
 	}
-	for (boost::unordered_map<int, Item::SharedTextLabel>::iterator t = core->getData()->textLabels.begin(); t != core->getData()->textLabels.end(); ++t)
+	while (!cell->mapIcons.empty() && migrated < count)
 	{
-		addTextLabel(t->second);
+		Item::SharedMapIcon mapIcon = cell->mapIcons.begin()->second;
+		removeMapIcon(mapIcon, true);
+		if (!cell->mapIcons.empty() && cell->mapIcons.begin()->second == mapIcon)
+		{
+			cell->mapIcons.quick_erase(cell->mapIcons.begin());
+			++cell->version;
+		}
+		++migrated;
+	}
+	while (!cell->objects.empty() && migrated < count)
+	{
+		Item::SharedObject object = cell->objects.begin()->second;
+		removeObject(object, true);
+		if (!cell->objects.empty() && cell->objects.begin()->second == object)
+		{
+			cell->objects.quick_erase(cell->objects.begin());
+			++cell->version;
+		}
+		++migrated;
+	}
+	while (!cell->pickups.empty() && migrated < count)
+	{
+		Item::SharedPickup pickup = cell->pickups.begin()->second;
+		removePickup(pickup, true);
+		if (!cell->pickups.empty() && cell->pickups.begin()->second == pickup)
+		{
+			cell->pickups.quick_erase(cell->pickups.begin());
+			++cell->version;
+		}
+		++migrated;
+	}
+	while (!cell->raceCheckpoints.empty() && migrated < count)
+	{
+		Item::SharedRaceCheckpoint raceCheckpoint = cell->raceCheckpoints.begin()->second;
+		removeRaceCheckpoint(raceCheckpoint, true);
+		if (!cell->raceCheckpoints.empty() && cell->raceCheckpoints.begin()->second == raceCheckpoint)
+		{
+			cell->raceCheckpoints.quick_erase(cell->raceCheckpoints.begin());
+			++cell->version;
+		}
+		++migrated;
+	}
+	while (!cell->textLabels.empty() && migrated < count)
+	{
+		Item::SharedTextLabel textLabel = cell->textLabels.begin()->second;
+		removeTextLabel(textLabel, true);
+		if (!cell->textLabels.empty() && cell->textLabels.begin()->second == textLabel)
+		{
+			cell->textLabels.quick_erase(cell->textLabels.begin());
+			++cell->version;
+		}
+		++migrated;
 	}
-	for (boost::unordered_map<int, Item::SharedVehicle>::iterator v = core->getData()->vehicles.begin(); v != core->getData()->vehicles.end(); ++v)
+	while (!cell->vehicles.empty() && migrated < count)
 	{
-		addVehicle(v->second);
+		Item::SharedVehicle vehicle = cell->vehicles.begin()->second;
+		removeVehicle(vehicle, true);
+		if (!cell->vehicles.empty() && cell->vehicles.begin()->second == vehicle)
+		{
+			cell->vehicles.quick_erase(cell->vehicles.begin());
+			++cell->version;
+		}
+		++migrated;
 	}
+	return migrated;
 }
 
 void Grid::removeActor(const Item::SharedActor &actor, bool reassign)
@@ -284,14 +446,15 @@ void Grid::removeActor(const Item::SharedActor &actor, bool reassign)
 	bool found = false;
 	if (actor->cell)
 	{
-		boost::unordered_map<CellID, SharedCell>::iterator c = cells.find(actor->cell->cellID);
-		if (c != cells.end())
+		SharedCell c = findCell(actor->cell);
+		if (c)
 		{
-			boost::unordered_map<int, Item::SharedActor>::iterator a = c->second->actors.find(actor->actorID);
-			if (a != c->second->actors.end())
+			boost::unordered_map<int, Item::SharedActor>::iterator a = c->actors.find(actor->actorID);
+			if (a != c->actors.end())
 			{
-				c->second->actors.quick_erase(a);
-				eraseCellIfEmpty(c->second);
+				c->actors.quick_erase(a);
+				++c->version;
+				eraseCellIfEmpty(c);
 				found = true;
 			}
 		}
@@ -302,8 +465,19 @@ void Grid::removeActor(const Item::SharedActor &actor, bool reassign)
 		if (a != globalCell->actors.end())
 		{
 			globalCell->actors.quick_erase(a);
+			++globalCell->version;
 			found = true;
 		}
+		else if (previousGlobalCell)
+		{
+			a = previousGlobalCell->actors.find(actor->actorID);
+			if (a != previousGlobalCell->actors.end())
+			{
+				previousGlobalCell->actors.quick_erase(a);
+				++previousGlobalCell->version;
+				found = true;
+			}
+		}
 	}
 	if (found)
 	{
@@ -319,14 +493,15 @@ void Grid::removeArea(const Item::SharedArea &area, bool reassign)
 	bool found = false;
 	if (area->cell)
 	{
-		boost::unordered_map<CellID, SharedCell>::iterator c = cells.find(area->cell->cellID);
-		if (c != cells.end())
+		SharedCell c = findCell(area->cell);
+		if (c)
 		{
-			boost::unordered_map<int, Item::SharedArea>::iterator a = c->second->areas.find(area->areaID);
-			if (a != c->second->areas.end())
+			boost::unordered_map<int, Item::SharedArea>::iterator a = c->areas.find(area->areaID);
+			if (a != c->areas.end())
 			{
-				c->second->areas.quick_erase(a);
-				eraseCellIfEmpty(c->second);
+				c->areas.quick_erase(a);
+				++c->version;
+				eraseCellIfEmpty(c);
 				found = true;
 			}
 		}
@@ -337,11 +512,23 @@ void Grid::removeArea(const Item::SharedArea &area, bool reassign)
 		if (a != globalCell->areas.end())
 		{
 			globalCell->areas.quick_erase(a);
+			++globalCell->version;
 			found = true;
 		}
+		else if (previousGlobalCell)
+		{
+			a = previousGlobalCell->areas.find(area->areaID);
+			if (a != previousGlobalCell->areas.end())
+			{
+				previousGlobalCell->areas.quick_erase(a);
+				++previousGlobalCell->version;
+				found = true;
+			}
+		}
 	}
 	if (found)
 	{
+		unindexArea(area);
 		if (reassign)
 		{
 			addArea(area);
@@ -361,14 +548,15 @@ void Grid::removeCheckpoint(const Item::SharedCheckpoint &checkpoint, bool reass
 	bool found = false;
 	if (checkpoint->cell)
 	{
-		boost::unordered_map<CellID, SharedCell>::iterator c = cells.find(checkpoint->cell->cellID);
-		if (c != cells.end())
+		SharedCell c = findCell(checkpoint->cell);
+		if (c)
 		{
-			boost::unordered_map<int, Item::SharedCheckpoint>::iterator d = c->second->checkpoints.find(checkpoint->checkpointID);
-			if (d != c->second->checkpoints.end())
+			boost::unordered_map<int, Item::SharedCheckpoint>::iterator d = c->checkpoints.find(checkpoint->checkpointID);
+			if (d != c->checkpoints.end())
 			{
-				c->second->checkpoints.quick_erase(d);
-				eraseCellIfEmpty(c->second);
+				c->checkpoints.quick_erase(d);
+				++c->version;
+				eraseCellIfEmpty(c);
 				found = true;
 			}
 		}
@@ -379,8 +567,19 @@ void Grid::removeCheckpoint(const Item::SharedCheckpoint &checkpoint, bool reass
 		if (c != globalCell->checkpoints.end())
 		{
 			globalCell->checkpoints.quick_erase(c);
+			++globalCell->version;
 			found = true;
 		}
+		else if (previousGlobalCell)
+		{
+			c = previousGlobalCell->checkpoints.find(checkpoint->checkpointID);
+			if (c != previousGlobalCell->checkpoints.end())
+			{
+				previousGlobalCell->checkpoints.quick_erase(c);
+				++previousGlobalCell->version;
+				found = true;
+			}
+		}
 	}
 	if (found)
 	{
@@ -396,14 +595,15 @@ void Grid::removeMapIcon(const Item::SharedMapIcon &mapIcon, bool reassign)
 	bool found = false;
 	if (mapIcon->cell)
 	{
-		boost::unordered_map<CellID, SharedCell>::iterator c = cells.find(mapIcon->cell->cellID);
-		if (c != cells.end())
+		SharedCell c = findCell(mapIcon->cell);
+		if (c)
 		{
-			boost::unordered_map<int, Item::SharedMapIcon>::iterator m = c->second->mapIcons.find(mapIcon->mapIconID);
-			if (m != c->second->mapIcons.end())
+			boost::unordered_map<int, Item::SharedMapIcon>::iterator m = c->mapIcons.find(mapIcon->mapIconID);
+			if (m != c->mapIcons.end())
 			{
-				c->second->mapIcons.quick_erase(m);
-				eraseCellIfEmpty(c->second);
+				c->mapIcons.quick_erase(m);
+				++c->version;
+				eraseCellIfEmpty(c);
 				found = true;
 			}
 		}
@@ -414,8 +614,19 @@ void Grid::removeMapIcon(const Item::SharedMapIcon &mapIcon, bool reassign)
 		if (m != globalCell->mapIcons.end())
 		{
 			globalCell->mapIcons.quick_erase(m);
+			++globalCell->version;
 			found = true;
 		}
+		else if (previousGlobalCell)
+		{
+			m = previousGlobalCell->mapIcons.find(mapIcon->mapIconID);
+			if (m != previousGlobalCell->mapIcons.end())
+			{
+				previousGlobalCell->mapIcons.quick_erase(m);
+				++previousGlobalCell->version;
+				found = true;
+			}
+		}
 	}
 	if (found)
 	{
@@ -428,17 +639,22 @@ void Grid::removeMapIcon(const Item::SharedMapIcon &mapIcon, bool reassign)
 
 void Grid::removeObject(const Item::SharedObject &object, bool reassign)
 {
+	if (reassign && object->attach && object->attach->assigned && isCurrentCell(object->cell, object->comparableStreamDistance, object->worlds, Eigen::Vector2f(object->attach->position[0], object->attach->position[1])))
+	{
+		return;
+	}
 	bool found = false;
 	if (object->cell)
 	{
-		boost::unordered_map<CellID, SharedCell>::iterator c = cells.find(object->cell->cellID);
-		if (c != cells.end())
+		SharedCell c = findCell(object->cell);
+		if (c)
 		{
-			boost::unordered_map<int, Item::SharedObject>::iterator o = c->second->objects.find(object->objectID);
-			if (o != c->second->objects.end())
+			boost::unordered_map<int, Item::SharedObject>::iterator o = c->objects.find(object->objectID);
+			if (o != c->objects.end())
 			{
-				c->second->objects.quick_erase(o);
-				eraseCellIfEmpty(c->second);
+				c->objects.quick_erase(o);
+				++c->version;
+				eraseCellIfEmpty(c);
 				found = true;
 			}
 		}
@@ -449,8 +665,19 @@ void Grid::removeObject(const Item::SharedObject &object, bool reassign)
 		if (o != globalCell->objects.end())
 		{
 			globalCell->objects.quick_erase(o);
+			++globalCell->version;
 			found = true;
 		}
+		else if (previousGlobalCell)
+		{
+			o = previousGlobalCell->objects.find(object->objectID);
+			if (o != previousGlobalCell->objects.end())
+			{
+				previousGlobalCell->objects.quick_erase(o);
+				++previousGlobalCell->version;
+				found = true;
+			}
+		}
 	}
 	if (found)
 	{
@@ -464,10 +691,6 @@ void Grid::removeObject(const Item::SharedObject &object, bool reassign)
 			{
 				core->getStreamer()->attachedObjects.erase(object);
 			}
-			if (object->move)
-			{
-				core->getStreamer()->movingObjects.erase(object);
-			}
 		}
 	}
 }
@@ -477,14 +700,15 @@ void Grid::removePickup(const Item::SharedPickup &pickup, bool reassign)
 	bool found = false;
 	if (pickup->cell)
 	{
-		boost::unordered_map<CellID, SharedCell>::iterator c = cells.find(pickup->cell->cellID);
-		if (c != cells.end())
+		SharedCell c = findCell(pickup->cell);
+		if (c)
 		{
-			boost::unordered_map<int, Item::SharedPickup>::iterator p = c->second->pickups.find(pickup->pickupID);
-			if (p != c->second->pickups.end())
+			boost::unordered_map<int, Item::SharedPickup>::iterator p = c->pickups.find(pickup->pickupID);
+			if (p != c->pickups.end())
 			{
-				c->second->pickups.quick_erase(p);
-				eraseCellIfEmpty(c->second);
+				c->pickups.quick_erase(p);
+				++c->version;
+				eraseCellIfEmpty(c);
 				found = true;
 			}
 		}
@@ -495,8 +719,19 @@ void Grid::removePickup(const Item::SharedPickup &pickup, bool reassign)
 		if (p != globalCell->pickups.end())
 		{
 			globalCell->pickups.quick_erase(p);
+			++globalCell->version;
 			found = true;
 		}
+		else if (previousGlobalCell)
+		{
+			p = previousGlobalCell->pickups.find(pickup->pickupID);
+			if (p != previousGlobalCell->pickups.end())
+			{
+				previousGlobalCell->pickups.quick_erase(p);
+				++previousGlobalCell->version;
+				found = true;
+			}
+		}
 	}
 	if (found)
 	{
@@ -512,14 +747,15 @@ void Grid::removeRaceCheckpoint(const Item::SharedRaceCheckpoint &raceCheckpoint
 	bool found = false;
 	if (raceCheckpoint->cell)
 	{
-		boost::unordered_map<CellID, SharedCell>::iterator c = cells.find(raceCheckpoint->cell->cellID);
-		if (c != cells.end())
+		SharedCell c = findCell(raceCheckpoint->cell);
+		if (c)
 		{
-			boost::unordered_map<int, Item::SharedRaceCheckpoint>::iterator r = c->second->raceCheckpoints.find(raceCheckpoint->raceCheckpointID);
-			if (r != c->second->raceCheckpoints.end())
+			boost::unordered_map<int, Item::SharedRaceCheckpoint>::iterator r = c->raceCheckpoints.find(raceCheckpoint->raceCheckpointID);
+			if (r != c->raceCheckpoints.end())
 			{
-				c->second->raceCheckpoints.quick_erase(r);
-				eraseCellIfEmpty(c->second);
+				c->raceCheckpoints.quick_erase(r);
+				++c->version;
+				eraseCellIfEmpty(c);
 				found = true;
 			}
 		}
@@ -530,8 +766,19 @@ void Grid::removeRaceCheckpoint(const Item::SharedRaceCheckpoint &raceCheckpoint
 		if (r != globalCell->raceCheckpoints.end())
 		{
 			globalCell->raceCheckpoints.quick_erase(r);
+			++globalCell->version;
 			found = true;
 		}
+		else if (previousGlobalCell)
+		{
+			r = previousGlobalCell->raceCheckpoints.find(raceCheckpoint->raceCheckpointID);
+			if (r != previousGlobalCell->raceCheckpoints.end())
+			{
+				previousGlobalCell->raceCheckpoints.quick_erase(r);
+				++previousGlobalCell->version;
+				found = true;
+			}
+		}
 	}
 	if (found)
 	{
@@ -544,17 +791,22 @@ void Grid::removeRaceCheckpoint(const Item::SharedRaceCheckpoint &raceCheckpoint
 
 void Grid::removeTextLabel(const Item::SharedTextLabel &textLabel, bool reassign)
 {
+	if (reassign && textLabel->attach && textLabel->attach->assigned && isCurrentCell(textLabel->cell, textLabel->comparableStreamDistance, textLabel->worlds, Eigen::Vector2f(textLabel->attach->position[0], textLabel->attach->position[1])))
+	{
+		return;
+	}
 	bool found = false;
 	if (textLabel->cell)
 	{
-		boost::unordered_map<CellID, SharedCell>::iterator c = cells.find(textLabel->cell->cellID);
-		if (c != cells.end())
+		SharedCell c = findCell(textLabel->cell);
+		if (c)
 		{
-			boost::unordered_map<int, Item::SharedTextLabel>::iterator t = c->second->textLabels.find(textLabel->textLabelID);
-			if (t != c->second->textLabels.end())
+			boost::unordered_map<int, Item::SharedTextLabel>::iterator t = c->textLabels.find(textLabel->textLabelID);
+			if (t != c->textLabels.end())
 			{
-				c->second->textLabels.quick_erase(t);
-				eraseCellIfEmpty(c->second);
+				c->textLabels.quick_erase(t);
+				++c->version;
+				eraseCellIfEmpty(c);
 				found = true;
 			}
 		}
@@ -565,8 +817,19 @@ void Grid::removeTextLabel(const Item::SharedTextLabel &textLabel, bool reassign
 		if (t != globalCell->textLabels.end())
 		{
 			globalCell->textLabels.quick_erase(t);
+			++globalCell->version;
 			found = true;
 		}
+		else if (previousGlobalCell)
+		{
+			t = previousGlobalCell->textLabels.find(textLabel->textLabelID);
+			if (t != previousGlobalCell->textLabels.end())
+			{
+				previousGlobalCell->textLabels.quick_erase(t);
+				++previousGlobalCell->version;
+				found = true;
+			}
+		}
 	}
 	if (found)
 	{
@@ -589,14 +852,15 @@ void Grid::removeVehicle(const Item::SharedVehicle &vehicle, bool reassign)
 	bool found = false;
 	if (vehicle->cell)
 	{
-		boost::unordered_map<CellID, SharedCell>::iterator c = cells.find(vehicle->cell->cellID);
-		if (c != cells.end())
+		SharedCell c = findCell(vehicle->cell);
+		if (c)
 		{
-			boost::unordered_map<int, Item::SharedVehicle>::iterator p = c->second->vehicles.find(vehicle->vehicleID);
-			if (p != c->second->vehicles.end())
+			boost::unordered_map<int, Item::SharedVehicle>::iterator p = c->vehicles.find(vehicle->vehicleID);
+			if (p != c->vehicles.end())
 			{
-				c->second->vehicles.quick_erase(p);
-				eraseCellIfEmpty(c->second);
+				c->vehicles.quick_erase(p);
+				++c->version;
+				eraseCellIfEmpty(c);
 				found = true;
 			}
 		}
@@ -607,8 +871,19 @@ void Grid::removeVehicle(const Item::SharedVehicle &vehicle, bool reassign)
 		if (p != globalCell->vehicles.end())
 		{
 			globalCell->vehicles.quick_erase(p);
+			++globalCell->version;
 			found = true;
 		}
+		else if (previousGlobalCell)
+		{
+			p = previousGlobalCell->vehicles.find(vehicle->vehicleID);
+			if (p != previousGlobalCell->vehicles.end())
+			{
+				previousGlobalCell->vehicles.quick_erase(p);
+				++previousGlobalCell->version;
+				found = true;
+			}
+		}
 	}
 	if (found)
 	{
@@ -623,28 +898,282 @@ void Grid::removeVehicle(const Item::SharedVehicle &vehicle, bool reassign)
 	}
 }
 
-CellID Grid::getCellID(const Eigen::Vector2f &position, bool insert)
+void Grid::indexArea(const Item::SharedArea &area)
+{
+	Box2D envelope;
+	boost::variant<Polygon2D, Box2D, Box3D, Eigen::Vector2f, Eigen::Vector3f> position;
+	if (area->attach)
+	{
+		position = area->attach->position;
+	}
+	else
+	{
+		position = area->position;
+	}
+	switch (area->type)
+	{
+		case STREAMER_AREA_TYPE_CIRCLE:
+		case STREAMER_AREA_TYPE_CYLINDER:
+		{
+			envelope.min_corner() = boost::get<Eigen::Vector2f>(position).array() - area->size;
+			envelope.max_corner() = boost::get<Eigen::Vector2f>(position).array() + area->size;
+			break;
+		}
+		case STREAMER_AREA_TYPE_SPHERE:
+		{
+			envelope.min_corner() = boost::get<Eigen::Vector3f>(position).head<2>().array() - area->size;
+			envelope.max_corner() = boost::get<Eigen::Vector3f>(position).head<2>().array() + area->size;
+			break;
+		}
+		case STREAMER_AREA_TYPE_RECTANGLE:
+		{
+			envelope = boost::get<Box2D>(position);
+			break;
+		}
+		case STREAMER_AREA_TYPE_CUBOID:
+		{
+			envelope.min_corner() = boost::get<Box3D>(position).min_corner().head<2>();
+			envelope.max_corner() = boost::get<Box3D>(position).max_corner().head<2>();
+			break;
+		}
+		case STREAMER_AREA_TYPE_POLYGON:
+		{
+			if (boost::get<Polygon2D>(position).outer().empty())
+			{
+				return;
+			}
+			boost::geometry::envelope(boost::get<Polygon2D>(position), envelope);
+			break;
+		}
+		default:
+		{
+			return;
+		}
+	}
+	if (envelope.min_corner().allFinite() && envelope.max_corner().allFinite())
+	{
+		areaIndex.insert(std::make_pair(envelope, area));
+		areaEnvelopes[area->areaID] = envelope;
+	}
+}
+
+void Grid::unindexArea(const Item::SharedArea &area)
+{
+	boost::unordered_map<int, Box2D>::iterator e = areaEnvelopes.find(area->areaID);
+	if (e != areaEnvelopes.end())
+	{
+		areaIndex.remove(std::make_pair(e->second, area));
+		areaEnvelopes.quick_erase(e);
+	}
+}
+
+CellID Grid::getCellID(const Level &level, const Eigen::Vector2f &position)
+{
+	return std::make_pair(static_cast<int>(std::floor(position[0] * level.inverseCellSize)), static_cast<int>(std::floor(position[1] * level.inverseCellSize)));
+}
+
+float Grid::getCellExitTime(const SharedCell &cell, const Eigen::Vector2f &position, const Eigen::Vector2f &velocity)
+{
+	if (cell->level >= static_cast<int>(levels.size()) || findCell(levels[cell->level], cell->worldID, cell->cellID) != cell)
+	{
+		return 0.0f;
+	}
+	float cellSize = levels[cell->level].cellSize, exitTime = std::numeric_limits<float>::infinity();
+	Eigen::Vector2f minimum(static_cast<float>(cell->cellID.first) * cellSize, static_cast<float>(cell->cellID.second) * cellSize);
+	for (int i = 0; i < 2; ++i)
+	{
+		if (velocity[i] > 0.0f)
+		{
+			exitTime = std::min(exitTime, (minimum[i] + cellSize - position[i]) / velocity[i]);
+		}
+		else if (velocity[i] < 0.0f)
+		{
+			exitTime = std::min(exitTime, (minimum[i] - position[i]) / velocity[i]);
+		}
+		else if (position[i] < minimum[i] || position[i] >= minimum[i] + cellSize)
+		{
+			return 0.0f;
+		}
+	}
+	return exitTime;
+}
+
+SharedCell Grid::getCell(int level, int worldID, const Eigen::Vector2f &position)
 {
-	static Box2D box;
-	box.min_corner()[0] = std::floor((position[0] / cellSize)) * cellSize;
-	box.min_corner()[1] = std::floor((position[1] / cellSize)) * cellSize;
-	box.max_corner()[0] = box.min_corner()[0] + cellSize;
-	box.max_corner()[1] = box.min_corner()[1] + cellSize;
-	Eigen::Vector2f centroid = boost::geometry::return_centroid<Eigen::Vector2f>(box);
-	CellID cellID = std::make_pair(static_cast<int>(centroid[0]), static_cast<int>(centroid[1]));
-	if (insert)
+	Level &gridLevel = levels[level];
+	CellID cellID = getCellID(gridLevel, position);
+	if (worldID >= 0)
 	{
-		boost::unordered_map<CellID, SharedCell>::iterator c = cells.find(cellID);
+		CellMap &cells = gridLevel.worldCells[worldID];
+		CellMap::iterator c = cells.find(cellID);
 		if (c == cells.end())
 		{
-			SharedCell cell(new Cell(cellID));
-			cells[cellID] = cell;
+			c = cells.insert(std::make_pair(cellID, SharedCell(new Cell(cellID, level, worldID)))).first;
+			++gridLevel.size;
+		}
+		return c->second;
+	}
+	if (isDenseCell(gridLevel, cellID))
+	{
+		SharedCell &cell = gridLevel.denseCells[getDenseIndex(gridLevel, cellID)];
+		if (!cell)
+		{
+			cell = SharedCell(new Cell(cellID, level, -1));
+			++gridLevel.size;
+		}
+		return cell;
+	}
+	CellMap::iterator c = gridLevel.cells.find(cellID);
+	if (c == gridLevel.cells.end())
+	{
+		c = gridLevel.cells.insert(std::make_pair(cellID, SharedCell(new Cell(cellID, level, -1)))).first;
+		++gridLevel.size;
+	}
+	return c->second;
+}
+
+void Grid::findCellsForPoint(std::vector<Level> &gridLevels, const Eigen::Vector2f &point, float range, std::vector<SharedCell> &pointCells)
+{
+	float comparableRange = range * range;
+	for (std::vector<Level>::iterator l = gridLevels.begin(); l != gridLevels.end(); ++l)
+	{
+		if (!l->size)
+		{
+			continue;
+		}
+		for (boost::unordered_map<int, CellMap>::iterator w = l->worldCells.begin(); w != l->worldCells.end(); ++w)
+		{
+			findCellsInRange(*l, w->second, point, range, pointCells);
+		}
+		float denseMin = static_cast<float>(l->denseOrigin), denseMax = static_cast<float>(l->denseOrigin + l->denseWidth - 1);
+		int minX = static_cast<int>(std::max(std::floor((point[0] - range) * l->inverseCellSize), denseMin));
+		int minY = static_cast<int>(std::max(std::floor((point[1] - range) * l->inverseCellSize), denseMin));
+		int maxX = static_cast<int>(std::min(std::floor((point[0] + range) * l->inverseCellSize), denseMax));
+		int maxY = static_cast<int>(std::min(std::floor((point[1] + range) * l->inverseCellSize), denseMax));
+		for (int y = minY; y <= maxY; ++y)
+		{
+			for (int x = minX; x <= maxX; ++x)
+			{
+				const SharedCell &cell = l->denseCells[getDenseIndex(*l, std::make_pair(x, y))];
+				if (cell && isCellInRange(*l, cell->cellID, point, comparableRange))
+				{
+					pointCells.push_back(cell);
+				}
+			}
+		}
+		findCellsInRange(*l, l->cells, point, range, pointCells);
+	}
+}
+
+void Grid::findCellsInRange(const Level &level, const CellMap &cells, const Eigen::Vector2f &point, float range, std::vector<SharedCell> &pointCells)
+{
+	float comparableRange = range * range;
+	float width = std::ceil((range * 2.0f) * level.inverseCellSize) + 1.0f;
+	if (!((width * width) <= static_cast<float>(cells.size())))
+	{
+		for (CellMap::const_iterator c = cells.begin(); c != cells.end(); ++c)
+		{
+			if (isCellInRange(level, c->first, point, comparableRange))
+			{
+				pointCells.push_back(c->second);
+			}
+		}
+		return;
+	}
+	CellID minID = getCellID(level, Eigen::Vector2f(point[0] - range, point[1] - range));
+	CellID maxID = getCellID(level, Eigen::Vector2f(point[0] + range, point[1] + range));
+	for (int y = minID.second; y <= maxID.second; ++y)
+	{
+		for (int x = minID.first; x <= maxID.first; ++x)
+		{
+			CellID cellID = std::make_pair(x, y);
+			if (isCellInRange(level, cellID, point, comparableRange))
+			{
+				CellMap::const_iterator c = cells.find(cellID);
+				if (c != cells.end())
+				{
+					pointCells.push_back(c->second);
+				}
+			}
+		}
+	}
+}
+
+void Grid::findNeighbouringCells(const Eigen::Vector2f &position, int worldID, std::vector<SharedCell> &foundCells, boost::unordered_set<Cell*> *discoveredCells)
+{
+	findNeighbouringCells(levels, position, worldID, foundCells, discoveredCells);
+	if (isRebuildingGrid())
+	{
+		findNeighbouringCells(previousLevels, position, worldID, foundCells, discoveredCells);
+	}
+}
+
+void Grid::findNeighbouringCells(std::vector<Level> &gridLevels, const Eigen::Vector2f &position, int worldID, std::vector<SharedCell> &foundCells, boost::unordered_set<Cell*> *discoveredCells)
+{
+	for (std::vector<Level>::iterator l = gridLevels.begin(); l != gridLevels.end(); ++l)
+	{
+		if (!l->size)
+		{
+			continue;
+		}
+		CellID centerID = getCellID(*l, position);
+		boost::unordered_map<int, CellMap>::iterator w = l->worldCells.find(worldID);
+		if (w != l->worldCells.end())
+		{
+			for (int y = -1; y <= 1; ++y)
+			{
+				for (int x = -1; x <= 1; ++x)
+				{
+					CellMap::iterator c = w->second.find(std::make_pair(centerID.first + x, centerID.second + y));
+					if (c != w->second.end())
+					{
+						if (discoveredCells)
+						{
+							discoveredCells->insert(c->second.get());
+						}
+						foundCells.push_back(c->second);
+					}
+				}
+			}
+		}
+		if (isDenseCell(*l, std::make_pair(centerID.first - 1, centerID.second - 1)) && isDenseCell(*l, std::make_pair(centerID.first + 1, centerID.second + 1)))
+		{
+			SharedCell *row = &l->denseCells[getDenseIndex(*l, centerID)] - l->denseWidth - 1;
+			for (int y = 0; y < 3; ++y, row += l->denseWidth)
+			{
+				for (int x = 0; x < 3; ++x)
+				{
+					if (row[x])
+					{
+						if (discoveredCells)
+						{
+							discoveredCells->insert(row[x].get());
+						}
+						foundCells.push_back(row[x]);
+					}
+				}
+			}
+			continue;
+		}
+		for (int y = -1; y <= 1; ++y)
+		{
+			for (int x = -1; x <= 1; ++x)
+			{
+				SharedCell cell = findCell(*l, std::make_pair(centerID.first + x, centerID.second + y));
+				if (cell)
+				{
+					if (discoveredCells)
+					{
+						discoveredCells->insert(cell.get());
+					}
+					foundCells.push_back(cell);
+				}
+			}
 		}
 	}
-	return cellID;
 }
 
-void Grid::processDiscoveredCellsForPlayer(Player &player, std::vector<SharedCell> &playerCells, const boost::unordered_set<CellID> &discoveredCells)
+void Grid::processDiscoveredCellsForPlayer(Player &player, std::vector<SharedCell> &playerCells, const boost::unordered_set<Cell*> &discoveredCells)
 {
 	playerCells.push_back(SharedCell(new Cell()));;
 	if (player.enabledItems[STREAMER_TYPE_OBJECT])
@@ -654,7 +1183,7 @@ void Grid::processDiscoveredCellsForPlayer(Player &player, std::vector<SharedCel
 		{
 			if (o->second->cell)
 			{
-				boost::unordered_set<CellID>::iterator d = discoveredCells.find(o->second->cell->cellID);
+				boost::unordered_set<Cell*>::const_iterator d = discoveredCells.find(o->second->cell.get());
 				if (d != discoveredCells.end())
 				{
 					o = player.visibleCell->objects.erase(o);
@@ -678,7 +1207,7 @@ void Grid::processDiscoveredCellsForPlayer(Player &player, std::vector<SharedCel
 		{
 			if (c->second->cell)
 			{
-				boost::unordered_set<CellID>::iterator d = discoveredCells.find(c->second->cell->cellID);
+				boost::unordered_set<Cell*>::const_iterator d = discoveredCells.find(c->second->cell.get());
 				if (d != discoveredCells.end())
 				{
 					c = player.visibleCell->checkpoints.erase(c);
@@ -702,7 +1231,7 @@ void Grid::processDiscoveredCellsForPlayer(Player &player, std::vector<SharedCel
 		{
 			if (r->second->cell)
 			{
-				boost::unordered_set<CellID>::iterator d = discoveredCells.find(r->second->cell->cellID);
+				boost::unordered_set<Cell*>::const_iterator d = discoveredCells.find(r->second->cell.get());
 				if (d != discoveredCells.end())
 				{
 					r = player.visibleCell->raceCheckpoints.erase(r);
@@ -726,7 +1255,7 @@ void Grid::processDiscoveredCellsForPlayer(Player &player, std::vector<SharedCel
 		{
 			if (m->second->cell)
 			{
-				boost::unordered_set<CellID>::iterator d = discoveredCells.find(m->second->cell->cellID);
+				boost::unordered_set<Cell*>::const_iterator d = discoveredCells.find(m->second->cell.get());
 				if (d != discoveredCells.end())
 				{
 					m = player.visibleCell->mapIcons.erase(m);
@@ -750,7 +1279,7 @@ void Grid::processDiscoveredCellsForPlayer(Player &player, std::vector<SharedCel
 		{
 			if (t->second->cell)
 			{
-				boost::unordered_set<CellID>::iterator d = discoveredCells.find(t->second->cell->cellID);
+				boost::unordered_set<Cell*>::const_iterator d = discoveredCells.find(t->second->cell.get());
 				if (d != discoveredCells.end())
 				{
 					t = player.visibleCell->textLabels.erase(t);
@@ -767,30 +1296,6 @@ void Grid::processDiscoveredCellsForPlayer(Player &player, std::vector<SharedCel
 		}
 		playerCells.back()->textLabels.swap(player.visibleCell->textLabels);
 	}
-	if (player.enabledItems[STREAMER_TYPE_AREA])
-	{
-		boost::unordered_map<int, Item::SharedArea>::iterator a = player.visibleCell->areas.begin();
-		while (a != player.visibleCell->areas.end())
-		{
-			if (a->second->cell)
-			{
-				boost::unordered_set<CellID>::iterator d = discoveredCells.find(a->second->cell->cellID);
-				if (d != discoveredCells.end())
-				{
-					a = player.visibleCell->areas.erase(a);
-				}
-				else
-				{
-					++a;
-				}
-			}
-			else
-			{
-				a = player.visibleCell->areas.erase(a);
-			}
-		}
-		playerCells.back()->areas.swap(player.visibleCell->areas);
-	}
 /*
 	if (player.enabledItems[STREAMER_TYPE_VEHICLE])
 	{
@@ -799,7 +1304,7 @@ void Grid::processDiscoveredCellsForPlayer(Player &player, std::vector<SharedCel
 		{
 			if (a->second->cell)
 			{
-				boost::unordered_set<CellID>::iterator d = discoveredCells.find(a->second->cell->cellID);
+				boost::unordered_set<Cell*>::const_iterator d = discoveredCells.find(a->second->cell.get());
 				if (d != discoveredCells.end())
 				{
 					a = player.visibleCell->vehicles.erase(a);
@@ -821,45 +1326,50 @@ void Grid::processDiscoveredCellsForPlayer(Player &player, std::vector<SharedCel
 
 void Grid::findAllCellsForPlayer(Player &player, std::vector<SharedCell> &playerCells)
 {
-	boost::unordered_set<CellID> discoveredCells;
-	for (int i = 0; i < translationMatrix.cols(); ++i)
-	{
-		Eigen::Vector2f position = Eigen::Vector2f(player.position[0], player.position[1]) + translationMatrix.col(i);
-		boost::unordered_map<CellID, SharedCell>::iterator c = cells.find(getCellID(position, false));
-		if (c != cells.end())
-		{
-			discoveredCells.insert(c->first);
-			playerCells.push_back(c->second);
-		}
-	}
+	boost::unordered_set<Cell*> discoveredCells;
+	findNeighbouringCells(Eigen::Vector2f(player.position[0], player.position[1]), player.worldID, playerCells, &discoveredCells);
 	processDiscoveredCellsForPlayer(player, playerCells, discoveredCells);
 	playerCells.push_back(globalCell);
+	if (isRebuildingGrid())
+	{
+		playerCells.push_back(previousGlobalCell);
+	}
 }
 
 void Grid::findMinimalCellsForPlayer(Player &player, std::vector<SharedCell> &playerCells)
 {
-	for (int i = 0; i < translationMatrix.cols(); ++i)
+	findNeighbouringCells(Eigen::Vector2f(player.position[0], player.position[1]), player.worldID, playerCells);
+	playerCells.push_back(globalCell);
+	if (isRebuildingGrid())
 	{
-		Eigen::Vector2f position = Eigen::Vector2f(player.position[0], player.position[1]) + translationMatrix.col(i);
-		boost::unordered_map<CellID, SharedCell>::iterator c = cells.find(getCellID(position, false));
-		if (c != cells.end())
-		{
-			playerCells.push_back(c->second);
-		}
+		playerCells.push_back(previousGlobalCell);
 	}
-	playerCells.push_back(globalCell);
 }
 
-void Grid::findMinimalCellsForPoint(const Eigen::Vector2f &point, std::vector<SharedCell> &pointCells)
+void Grid::findCellsForPoint(const Eigen::Vector2f &point, float range, std::vector<SharedCell> &pointCells)
 {
-	for (int i = 0; i < translationMatrix.cols(); ++i)
+	findCellsForPoint(levels, point, std::fabs(range), pointCells);
+	pointCells.push_back(globalCell);
+	if (isRebuildingGrid())
 	{
-		Eigen::Vector2f position = point + translationMatrix.col(i);
-		boost::unordered_map<CellID, SharedCell>::iterator c = cells.find(getCellID(position, false));
-		if (c != cells.end())
-		{
-			pointCells.push_back(c->second);
-		}
+		findCellsForPoint(previousLevels, point, std::fabs(range), pointCells);
+		pointCells.push_back(previousGlobalCell);
+	}
+}
+
+void Grid::findAreasForPoint(const Eigen::Vector2f &point, std::vector<Item::SharedArea> &pointAreas)
+{
+	for (boost::geometry::index::rtree<std::pair<Box2D, Item::SharedArea>, boost::geometry::index::quadratic<16> >::const_query_iterator a = areaIndex.qbegin(boost::geometry::index::intersects(point)); a != areaIndex.qend(); ++a)
+	{
+		pointAreas.push_back(a->second);
+	}
+}
+
+void Grid::findAreasForLine(const Eigen::Vector2f &lineStart, const Eigen::Vector2f &lineEnd, std::vector<Item::SharedArea> &lineAreas)
+{
+	boost::geometry::model::segment<Eigen::Vector2f> segment(lineStart, lineEnd);
+	for (boost::geometry::index::rtree<std::pair<Box2D, Item::SharedArea>, boost::geometry::index::quadratic<16> >::const_query_iterator a = areaIndex.qbegin(boost::geometry::index::intersects(segment)); a != areaIndex.qend(); ++a)
+	{
+		lineAreas.push_back(a->second);
 	}
-	pointCells.push_back(globalCell);
 }
@@ -20,10 +20,13 @@
 #include "cell.h"
 #include "common.h"
 
+#include <boost/geometry/index/rtree.hpp>
 #include <boost/unordered_map.hpp>
 #include <boost/unordered_set.hpp>
 
+#include <algorithm>
 #include <cmath>
+#include <utility>
 #include <vector>
 
 class Grid
@@ -62,7 +65,61 @@ public:
 		comparableCellDistance = distance * distance;
 	}
 
+	float getCellExitTime(const SharedCell &cell, const Eigen::Vector2f &position, const Eigen::Vector2f &velocity);
+
+	inline bool isRebuildingGrid()
+	{
+		return previousGlobalCell.get() != NULL;
+	}
+
 	void rebuildGrid();
+	void processGridRebuild(std::size_t count);
+	void completeGridRebuild();
+
+	inline void reassignItem(const Item::SharedActor &actor)
+	{
+		removeActor(actor, true);
+	}
+
+	inline void reassignItem(const Item::SharedArea &area)
+	{
+		removeArea(area, true);
+	}
+
+	inline void reassignItem(const Item::SharedCheckpoint &checkpoint)
+	{
+		removeCheckpoint(checkpoint, true);
+	}
+
+	inline void reassignItem(const Item::SharedMapIcon &mapIcon)
+	{
+		removeMapIcon(mapIcon, true);
+	}
+
+	inline void reassignItem(const Item::SharedObject &object)
+	{
+		removeObject(object, true);
+	}
+
+	inline void reassignItem(const Item::SharedPickup &pickup)
+	{
+		removePickup(pickup, true);
+	}
+
+	inline void reassignItem(const Item::SharedRaceCheckpoint &raceCheckpoint)
+	{
+		removeRaceCheckpoint(raceCheckpoint, true);
+	}
+
+	inline void reassignItem(const Item::SharedTextLabel &textLabel)
+	{
+		removeTextLabel(textLabel, true);
+	}
+
+	inline void reassignItem(const Item::SharedVehicle &vehicle)
+	{
+		removeVehicle(vehicle, true);
+	}
 
 	void removeActor(const Item::SharedActor &actor, bool reassign = false);
 	void removeArea(const Item::SharedArea &area, bool reassign = false);
@@ -76,32 +133,225 @@ public:
 
 	void findAllCellsForPlayer(Player &player, std::vector<SharedCell> &playerCells);
 	void findMinimalCellsForPlayer(Player &player, std::vector<SharedCell> &playerCells);
-	void findMinimalCellsForPoint(const Eigen::Vector2f &point, std::vector<SharedCell> &pointCells);
+	void findCellsForPoint(const Eigen::Vector2f &point, float range, std::vector<SharedCell> &pointCells);
+
+	void findAreasForPoint(const Eigen::Vector2f &point, std::vector<Item::SharedArea> &pointAreas);
+	void findAreasForLine(const Eigen::Vector2f &lineStart, const Eigen::Vector2f &lineEnd, std::vector<Item::SharedArea> &lineAreas);
 private:
+	struct Level
+	{
+		float cellDistance;
+		float cellSize;
+		float inverseCellSize;
+
+		CellMap cells;
+		boost::unordered_map<int, CellMap> worldCells;
+
+		std::vector<SharedCell> denseCells;
+		int denseOrigin;
+		int denseWidth;
+		std::size_t size;
+	};
+
 	float cellDistance;
 	float cellSize;
 	float comparableCellDistance;
 	SharedCell globalCell;
 
-	boost::unordered_map<CellID, SharedCell> cells;
-	Eigen::Matrix<float, 2, 9> translationMatrix;
+	std::vector<Level> levels;
+	std::vector<Level> previousLevels;
+	SharedCell previousGlobalCell;
+	std::vector<SharedCell> previousCells;
 
-	inline void calculateTranslationMatrix()
+	boost::geometry::index::rtree<std::pair<Box2D, Item::SharedArea>, boost::geometry::index::quadratic<16> > areaIndex;
+	boost::unordered_map<int, Box2D> areaEnvelopes;
+
+	inline void calculateLevels()
+	{
+		levels.clear();
+		levels.resize(STREAMER_GRID_LEVELS);
+		for (std::size_t i = 0; i < levels.size(); ++i)
+		{
+			float scale = static_cast<float>(1 << i);
+			levels[i].cellDistance = cellDistance * scale * scale;
+			levels[i].cellSize = cellSize * scale;
+			levels[i].inverseCellSize = 1.0f / levels[i].cellSize;
+			int halfWidth = static_cast<int>(std::ceil(STREAMER_GRID_BOUNDS / levels[i].cellSize));
+			if (halfWidth > STREAMER_GRID_MAX_DENSE_CELLS / 2)
+			{
+				halfWidth = STREAMER_GRID_MAX_DENSE_CELLS / 2;
+			}
+			levels[i].denseOrigin = -halfWidth;
+			levels[i].denseWidth = halfWidth * 2;
+			levels[i].denseCells.resize(levels[i].denseWidth * levels[i].denseWidth);
+			levels[i].size = 0;
+		}
+	}
+
+	inline int findLevel(float comparableDistance)
 	{
-		translationMatrix << 0.0f, 0.0f, cellSize, cellSize, cellSize * -1.0f, 0.0f, cellSize * -1.0f, cellSize, cellSize * -1.0f,
-		                     0.0f, cellSize, 0.0f, cellSize, 0.0f, cellSize * -1.0f, cellSize, cellSize * -1.0f, cellSize * -1.0f;
+		if (comparableDistance >= STREAMER_STATIC_DISTANCE_CUTOFF)
+		{
+			for (std::size_t i = 0; i < levels.size(); ++i)
+			{
+				if (comparableDistance <= levels[i].cellDistance)
+				{
+					return static_cast<int>(i);
+				}
+			}
+		}
+		return -1;
+	}
+
+	inline int getWorldPartition(const boost::unordered_set<int> &worlds)
+	{
+		if (worlds.size() == 1)
+		{
+			return *worlds.begin();
+		}
+		return -1;
+	}
+
+	inline bool isDenseCell(const Level &level, const CellID &cellID)
+	{
+		return static_cast<unsigned int>(cellID.first - level.denseOrigin) < static_cast<unsigned int>(level.denseWidth) && static_cast<unsigned int>(cellID.second - level.denseOrigin) < static_cast<unsigned int>(level.denseWidth);
+	}
+
+	inline std::size_t getDenseIndex(const Level &level, const CellID &cellID)
+	{
+		return static_cast<std::size_t>(cellID.second - level.denseOrigin) * level.denseWidth + static_cast<std::size_t>(cellID.first - level.denseOrigin);
+	}
+
+	inline bool isCellInRange(const Level &level, const CellID &cellID, const Eigen::Vector2f &point, float comparableRange)
+	{
+		float minX = static_cast<float>(cellID.first) * level.cellSize, minY = static_cast<float>(cellID.second) * level.cellSize;
+		float deltaX = std::max(std::max(minX - point[0], point[0] - (minX + level.cellSize)), 0.0f);
+		float deltaY = std::max(std::max(minY - point[1], point[1] - (minY + level.cellSize)), 0.0f);
+		return (deltaX * deltaX) + (deltaY * deltaY) <= comparableRange;
+	}
+
+	inline SharedCell findCell(const Level &level, const CellID &cellID)
+	{
+		if (isDenseCell(level, cellID))
+		{
+			return level.denseCells[getDenseIndex(level, cellID)];
+		}
+		CellMap::const_iterator c = level.cells.find(cellID);
+		if (c != level.cells.end())
+		{
+			return c->second;
+		}
+		return SharedCell();
+	}
+
+	inline SharedCell findCell(const Level &level, int worldID, const CellID &cellID)
+	{
+		if (worldID < 0)
+		{
+			return findCell(level, cellID);
+		}
+		boost::unordered_map<int, CellMap>::const_iterator w = level.worldCells.find(worldID);
+		if (w != level.worldCells.end())
+		{
+			CellMap::const_iterator c = w->second.find(cellID);
+			if (c != w->second.end())
+			{
+				return c->second;
+			}
+		}
+		return SharedCell();
+	}
+
+	inline SharedCell findCell(const SharedCell &cell)
+	{
+		if (cell->level >= 0)
+		{
+			if (cell->level < static_cast<int>(levels.size()))
+			{
+				SharedCell c = findCell(levels[cell->level], cell->worldID, cell->cellID);
+				if (c == cell)
+				{
+					return c;
+				}
+			}
+			if (cell->level < static_cast<int>(previousLevels.size()))
+			{
+				SharedCell c = findCell(previousLevels[cell->level], cell->worldID, cell->cellID);
+				if (c == cell)
+				{
+					return c;
+				}
+			}
+		}
+		return SharedCell();
+	}
+
+	inline void eraseCell(Level &level, const SharedCell &cell)
+	{
+		if (cell->worldID >= 0)
+		{
+			boost::unordered_map<int, CellMap>::iterator w = level.worldCells.find(cell->worldID);
+			if (w != level.worldCells.end())
+			{
+				w->second.erase(cell->cellID);
+				if (w->second.empty())
+				{
+					level.worldCells.erase(w);
+				}
+			}
+		}
+		else if (isDenseCell(level, cell->cellID))
+		{
+			level.denseCells[getDenseIndex(level, cell->cellID)].reset();
+		}
+		else
+		{
+			level.cells.erase(cell->cellID);
+		}
+		--level.size;
 	}
 
 	inline void eraseCellIfEmpty(const SharedCell &cell)
 	{
 		if (cell->areas.empty() && cell->checkpoints.empty() && cell->mapIcons.empty() && cell->objects.empty() && cell->pickups.empty() && cell->raceCheckpoints.empty() && cell->textLabels.empty() && cell->actors.empty() && cell->vehicles.empty())
 		{
-			cells.erase(cell->cellID);
+			if (cell->level < static_cast<int>(levels.size()) && findCell(levels[cell->level], cell->worldID, cell->cellID) == cell)
+			{
+				eraseCell(levels[cell->level], cell);
+			}
+			else if (cell->level < static_cast<int>(previousLevels.size()))
+			{
+				eraseCell(previousLevels[cell->level], cell);
+			}
 		}
 	}
 
-	CellID getCellID(const Eigen::Vector2f &position, bool insert = true);
-	void processDiscoveredCellsForPlayer(Player &player, std::vector<SharedCell> &playerCells, const boost::unordered_set<CellID> &discoveredCells);
+	inline bool isCurrentCell(const SharedCell &cell, float comparableStreamDistance, const boost::unordered_set<int> &worlds, const Eigen::Vector2f &position)
+	{
+		int level = findLevel(comparableStreamDistance);
+		if (level < 0)
+		{
+			return !cell && !previousGlobalCell;
+		}
+		if (!cell || cell->level != level || cell->worldID != getWorldPartition(worlds))
+		{
+			return false;
+		}
+		return getCellID(levels[level], position) == cell->cellID && findCell(levels[level], cell->worldID, cell->cellID) == cell;
+	}
+
+	std::size_t migrateCell(const SharedCell &cell, std::size_t count);
+
+	void indexArea(const Item::SharedArea &area);
+	void unindexArea(const Item::SharedArea &area);
+
+	CellID getCellID(const Level &level, const Eigen::Vector2f &position);
+	SharedCell getCell(int level, int worldID, const Eigen::Vector2f &position);
+	void findCellsForPoint(std::vector<Level> &gridLevels, const Eigen::Vector2f &point, float range, std::vector<SharedCell> &pointCells);
+	void findCellsInRange(const Level &level, const CellMap &cells, const Eigen::Vector2f &point, float range, std::vector<SharedCell> &pointCells);
+	void findNeighbouringCells(std::vector<Level> &gridLevels, const Eigen::Vector2f &position, int worldID, std::vector<SharedCell> &foundCells, boost::unordered_set<Cell*> *discoveredCells);
+	void findNeighbouringCells(const Eigen::Vector2f &position, int worldID, std::vector<SharedCell> &foundCells, boost::unordered_set<Cell*> *discoveredCells = NULL);
+	void processDiscoveredCellsForPlayer(Player &player, std::vector<SharedCell> &playerCells, const boost::unordered_set<Cell*> &discoveredCells);
 };
 
 #endif
@@ -33,14 +33,14 @@ Item::Area::Attach::Attach() : references(0) {}
 Item::Checkpoint::Checkpoint() : references(0) {}
 Item::MapIcon::MapIcon() : references(0) {}
 Item::Object::Object() : references(0) {}
-Item::Object::Attach::Attach() : references(0) {}
+Item::Object::Attach::Attach() : assigned(false), references(0) {}
 Item::Object::Material::Main::Main() : references(0) {}
 Item::Object::Material::Text::Text() : references(0) {}
 Item::Object::Move::Move() : references(0) {}
 Item::Pickup::Pickup() : references(0) {}
 Item::RaceCheckpoint::RaceCheckpoint() : references(0) {}
 Item::TextLabel::TextLabel() : references(0) {}
-Item::TextLabel::Attach::Attach() : references(0) {}
+Item::TextLabel::Attach::Attach() : assigned(false), references(0) {}
 Item::Actor::Actor() : references(0) {}
 Item::Actor::Anim::Anim() : references(0) {}
-Item::Vehicle::Vehicle() : references(0) {}
\ No newline at end of file
+Item::Vehicle::Vehicle() : references(0), respawnScheduled(false) {}
\ No newline at end of file
@@ -217,6 +217,7 @@ namespace Item
 		{
 			Attach();
 
+			bool assigned;
 			int object;
 			int player;
 			Eigen::Vector3f position;
@@ -271,6 +272,7 @@ namespace Item
 		{
 			Move();
 
+			boost::chrono::steady_clock::time_point deadline;
 			int duration;
 			boost::tuple<Eigen::Vector3f, Eigen::Vector3f, Eigen::Vector3f> position;
 			int references;
@@ -381,6 +383,7 @@ namespace Item
 		{
 			Attach();
 
+			bool assigned;
 			int player;
 			Eigen::Vector3f position;
 			int references;
@@ -458,6 +461,7 @@ namespace Item
 		int vehicleID;
 		bool touched;
 		bool used;
+		bool respawnScheduled;
 		boost::chrono::steady_clock::time_point spawnedTime;
 		boost::chrono::steady_clock::time_point lastUpdatedTime;
 
@@ -52,10 +52,16 @@ AMX_NATIVE_INFO natives[] =
 	// Settings
 	{ "Streamer_GetTickRate", Natives::Streamer_GetTickRate },
 	{ "Streamer_SetTickRate", Natives::Streamer_SetTickRate },
+	{ "Streamer_GetTickBudget", Natives::Streamer_GetTickBudget },
+	{ "Streamer_SetTickBudget", Natives::Streamer_SetTickBudget },
 	{ "Streamer_GetPlayerTickRate", Natives::Streamer_GetPlayerTickRate },
 	{ "Streamer_SetPlayerTickRate", Natives::Streamer_SetPlayerTickRate },
+	{ "Streamer_GetPlayerCandidateMargin", Natives::Streamer_GetPlayerCandidateMargin },
+	{ "Streamer_SetPlayerCandidateMargin", Natives::Streamer_SetPlayerCandidateMargin },
 	{ "Streamer_GetChunkTickRate", Natives::Streamer_GetChunkTickRate },
 	{ "Streamer_SetChunkTickRate", Natives::Streamer_SetChunkTickRate },
+	{ "Streamer_GetChunkByteBudget", Natives::Streamer_GetChunkByteBudget },
+	{ "Streamer_SetChunkByteBudget", Natives::Streamer_SetChunkByteBudget },
 	{ "Streamer_GetChunkSize", Natives::Streamer_GetChunkSize },
 	{ "Streamer_SetChunkSize", Natives::Streamer_SetChunkSize },
 	{ "Streamer_GetMaxItems", Natives::Streamer_GetMaxItems },
@@ -87,6 +93,8 @@ AMX_NATIVE_INFO natives[] =
 	{ "Streamer_ToggleItemUpdate", Natives::Streamer_ToggleItemUpdate },
 	{ "Streamer_IsToggleItemUpdate", Natives::Streamer_IsToggleItemUpdate },
 	{ "Streamer_GetLastUpdateTime", Natives::Streamer_GetLastUpdateTime },
+	{ "Streamer_GetPendingPlayerUpdates", Natives::Streamer_GetPendingPlayerUpdates },
+	{ "Streamer_GetPlayerChunkBytes", Natives::Streamer_GetPlayerChunkBytes },
 	{ "Streamer_Update", Natives::Streamer_Update },
 	{ "Streamer_UpdateEx", Natives::Streamer_UpdateEx },
 	// Data Manipulation
@@ -321,12 +329,15 @@ AMX_NATIVE_INFO natives[] =
 PLUGIN_EXPORT int PLUGIN_CALL AmxLoad(AMX *amx)
 {
 	core->getData()->interfaces.insert(amx);
-	return Utility::checkInterfaceAndRegisterNatives(amx, natives);
+	int result = Utility::checkInterfaceAndRegisterNatives(amx, natives);
+	Utility::cacheInterface(amx);
+	return result;
 }
 
 PLUGIN_EXPORT int PLUGIN_CALL AmxUnload(AMX *amx)
 {
 	core->getData()->interfaces.erase(amx);
+	Utility::uncacheInterface(amx);
 	Utility::destroyAllItemsInInterface(amx);
 	return AMX_ERR_NONE;
 }
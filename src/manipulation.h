@@ -97,6 +97,11 @@ namespace Manipulation
 		InvalidID,
 		InvalidType
 	};
+
+	inline bool isConditionData(int data)
+	{
+		return data == AreaID || data == InteriorID || data == PlayerID || data == WorldID;
+	}
 }
 
 #include "manipulation/array.h"
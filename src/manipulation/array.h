@@ -17,6 +17,7 @@
 #ifndef MANIPULATION_ARRAY_H
 #define MANIPULATION_ARRAY_H
 
+#include "../core.h"
 #include "../manipulation.h"
 #include "../utility.h"
 
@@ -96,7 +97,9 @@ namespace Manipulation
 				}
 				case WorldID:
 				{
-					return Utility::convertArrayToContainer(amx, input, size, i->second->worlds) != 0;
+					bool result = Utility::convertArrayToContainer(amx, input, size, i->second->worlds) != 0;
+					core->getGrid()->reassignItem(i->second);
+					return result;
 				}
 				default:
 				{
@@ -177,7 +180,9 @@ namespace Manipulation
 				}
 				case WorldID:
 				{
-					return Utility::addToContainer(i->second->worlds, value) != 0;
+					bool result = Utility::addToContainer(i->second->worlds, value) != 0;
+					core->getGrid()->reassignItem(i->second);
+					return result;
 				}
 				default:
 				{
@@ -219,7 +224,9 @@ namespace Manipulation
 				}
 				case WorldID:
 				{
-					return Utility::removeFromContainer(i->second->worlds, value) != 0;
+					bool result = Utility::removeFromContainer(i->second->worlds, value) != 0;
+					core->getGrid()->reassignItem(i->second);
+					return result;
 				}
 				default:
 				{
@@ -19,6 +19,7 @@
 #include "../core.h"
 #include "../utility.h"
 
+#include <boost/chrono.hpp>
 #include <boost/geometry.hpp>
 #include <boost/geometry/geometries/geometries.hpp>
 #include <boost/intrusive_ptr.hpp>
@@ -45,6 +46,10 @@ int Manipulation::getFloatData(AMX *amx, cell *params)
 			boost::unordered_map<int, Item::SharedObject>::iterator o = core->getData()->objects.find(static_cast<int>(params[2]));
 			if (o != core->getData()->objects.end())
 			{
+				if (o->second->move)
+				{
+					core->getStreamer()->updateObjectMove(o->second, boost::chrono::steady_clock::now());
+				}
 				switch (static_cast<int>(params[3]))
 				{
 					case AttachOffsetX:
@@ -1080,6 +1085,10 @@ int Manipulation::setFloatData(AMX *amx, cell *params)
 							return 0;
 						}
 						o->second->position[2] = amx_ctof(params[4]);
+						if (o->second->cell)
+						{
+							++o->second->cell->version;
+						}
 						update = true;
 						break;
 					}
@@ -1101,7 +1110,9 @@ int Manipulation::setFloatData(AMX *amx, cell *params)
 						if (i != p->second.internalObjects.end())
 						{
 							sampgdk::DestroyPlayerObject(p->first, i->second);
+							p->second.reverseObjects.erase(i->second);
 							i->second = sampgdk::CreatePlayerObject(p->first, o->second->modelID, o->second->position[0], o->second->position[1], o->second->position[2], o->second->rotation[0], o->second->rotation[1], o->second->rotation[2], o->second->drawDistance);
+							p->second.reverseObjects.insert(i->second, o->first);
 							if (o->second->attach)
 							{
 								if (o->second->attach->object != INVALID_GENERIC_ID)
@@ -1109,7 +1120,7 @@ int Manipulation::setFloatData(AMX *amx, cell *params)
 									boost::unordered_map<int, int>::iterator j = p->second.internalObjects.find(o->second->attach->object);
 									if (j != p->second.internalObjects.end())
 									{
-										AMX_NATIVE native = sampgdk::FindNative("AttachPlayerObjectToObject");
+										AMX_NATIVE native = Utility::findNative(STREAMER_NATIVE_ATTACH_PLAYER_OBJECT_TO_OBJECT);
 										if (native != NULL)
 										{
 											sampgdk::InvokeNative(native, "dddffffffb", p->first, i->second, j->second, o->second->attach->positionOffset[0], o->second->attach->positionOffset[1], o->second->attach->positionOffset[2], o->second->attach->rotation[0], o->second->attach->rotation[1], o->second->attach->rotation[2], o->second->attach->syncRotation);
@@ -1118,7 +1129,7 @@ int Manipulation::setFloatData(AMX *amx, cell *params)
 								}
 								else if (o->second->attach->player != INVALID_GENERIC_ID)
 								{
-									AMX_NATIVE native = sampgdk::FindNative("AttachPlayerObjectToPlayer");
+									AMX_NATIVE native = Utility::findNative(STREAMER_NATIVE_ATTACH_PLAYER_OBJECT_TO_PLAYER);
 									if (native != NULL)
 									{
 										sampgdk::InvokeNative(native, "dddffffffd", p->first, i->second, o->second->attach->player, o->second->attach->positionOffset[0], o->second->attach->positionOffset[1], o->second->attach->positionOffset[2], o->second->attach->rotation[0], o->second->attach->rotation[1], o->second->attach->rotation[2], 1);
@@ -1218,7 +1229,9 @@ int Manipulation::setFloatData(AMX *amx, cell *params)
 					if (i != core->getData()->internalPickups.end())
 					{
 						sampgdk::DestroyPickup(i->second);
+						core->getData()->reversePickups.erase(i->second);
 						i->second = sampgdk::CreatePickup(p->second->modelID, p->second->type, p->second->position[0], p->second->position[1], p->second->position[2], p->second->worldID);
+						core->getData()->reversePickups.insert(i->second, p->first);
 					}
 				}
 				if (reassign || update)
@@ -1445,6 +1458,10 @@ int Manipulation::setFloatData(AMX *amx, cell *params)
 					case Z:
 					{
 						m->second->position[2] = amx_ctof(params[4]);
+						if (m->second->cell)
+						{
+							++m->second->cell->version;
+						}
 						update = true;
 						break;
 					}
@@ -1527,6 +1544,10 @@ int Manipulation::setFloatData(AMX *amx, cell *params)
 					case Z:
 					{
 						t->second->position[2] = amx_ctof(params[4]);
+						if (t->second->cell)
+						{
+							++t->second->cell->version;
+						}
 						update = true;
 						break;
 					}
@@ -1548,7 +1569,9 @@ int Manipulation::setFloatData(AMX *amx, cell *params)
 						if (i != p->second.internalTextLabels.end())
 						{
 							sampgdk::DeletePlayer3DTextLabel(p->first, i->second);
+							p->second.reverseTextLabels.erase(i->second);
 							i->second = sampgdk::CreatePlayer3DTextLabel(p->first, t->second->text.c_str(), t->second->color, t->second->position[0], t->second->position[1], t->second->position[2], t->second->drawDistance, t->second->attach ? t->second->attach->player : INVALID_GENERIC_ID, t->second->attach ? t->second->attach->vehicle : INVALID_GENERIC_ID, t->second->testLOS);
+							p->second.reverseTextLabels.insert(i->second, t->first);
 						}
 					}
 				}
@@ -1880,7 +1903,9 @@ int Manipulation::setFloatData(AMX *amx, cell *params)
 					if (i != core->getData()->internalActors.end())
 					{
 						sampgdk::DestroyActor(i->second);
+						core->getData()->reverseActors.erase(i->second);
 						i->second = sampgdk::CreateActor(a->second->modelID, a->second->position[0], a->second->position[1], a->second->position[2], a->second->rotation);
+						core->getData()->reverseActors.insert(i->second, a->first);
 						sampgdk::SetActorInvulnerable(i->second, a->second->invulnerable);
 						sampgdk::SetActorHealth(i->second, a->second->health);
 						sampgdk::SetActorVirtualWorld(i->second, a->second->worldID);
@@ -1995,7 +2020,9 @@ int Manipulation::setFloatData(AMX *amx, cell *params)
 					if (i != core->getData()->internalVehicles.end())
 					{
 						sampgdk::DestroyVehicle(i->second);
+						core->getData()->reverseVehicles.erase(i->second);
 						i->second = sampgdk::CreateVehicle(v->second->modelID, v->second->position[0], v->second->position[1], v->second->position[2], v->second->angle, v->second->color[0], v->second->color[1], -1, v->second->spawn.addsiren);
+						core->getData()->reverseVehicles.insert(i->second, v->first);
 						if (i->second == INVALID_VEHICLE_ID)
 						{
 							return 0;
@@ -609,7 +609,7 @@ int Manipulation::setIntData(AMX *amx, cell *params)
 								Utility::logError("Streamer_SetIntData: Object is currently moving and must be stopped first.");
 								return 0;
 							}
-							if (sampgdk::FindNative("SetPlayerGravity") == NULL)
+							if (Utility::findNative(STREAMER_NATIVE_SET_PLAYER_GRAVITY) == NULL)
 							{
 								Utility::logError("Streamer_SetIntData: YSF plugin must be loaded to attach objects to objects.");
 								return 0;
@@ -648,7 +648,7 @@ int Manipulation::setIntData(AMX *amx, cell *params)
 								Utility::logError("Streamer_SetIntData: Object is currently moving and must be stopped first.");
 								return 0;
 							}
-							if (sampgdk::FindNative("SetPlayerGravity") == NULL)
+							if (Utility::findNative(STREAMER_NATIVE_SET_PLAYER_GRAVITY) == NULL)
 							{
 								Utility::logError("Streamer_SetIntData: YSF plugin must be loaded to attach objects to players.");
 								return 0;
@@ -747,7 +747,9 @@ int Manipulation::setIntData(AMX *amx, cell *params)
 					}
 					case WorldID:
 					{
-						return Utility::setFirstValueInContainer(o->second->worlds, static_cast<int>(params[4])) != 0;
+						bool result = Utility::setFirstValueInContainer(o->second->worlds, static_cast<int>(params[4])) != 0;
+						core->getGrid()->reassignItem(o->second);
+						return result;
 					}
 					default:
 					{
@@ -763,7 +765,9 @@ int Manipulation::setIntData(AMX *amx, cell *params)
 						if (i != p->second.internalObjects.end())
 						{
 							sampgdk::DestroyPlayerObject(p->first, i->second);
+							p->second.reverseObjects.erase(i->second);
 							i->second = sampgdk::CreatePlayerObject(p->first, o->second->modelID, o->second->position[0], o->second->position[1], o->second->position[2], o->second->rotation[0], o->second->rotation[1], o->second->rotation[2], o->second->drawDistance);
+							p->second.reverseObjects.insert(i->second, o->first);
 							if (o->second->attach)
 							{
 								if (o->second->attach->object != INVALID_STREAMER_ID)
@@ -771,7 +775,7 @@ int Manipulation::setIntData(AMX *amx, cell *params)
 									boost::unordered_map<int, int>::iterator j = p->second.internalObjects.find(o->second->attach->object);
 									if (j != p->second.internalObjects.end())
 									{
-										AMX_NATIVE native = sampgdk::FindNative("AttachPlayerObjectToObject");
+										AMX_NATIVE native = Utility::findNative(STREAMER_NATIVE_ATTACH_PLAYER_OBJECT_TO_OBJECT);
 										if (native != NULL)
 										{
 											sampgdk::InvokeNative(native, "dddffffffb", p->first, i->second, j->second, o->second->attach->positionOffset[0], o->second->attach->positionOffset[1], o->second->attach->positionOffset[2], o->second->attach->rotation[0], o->second->attach->rotation[1], o->second->attach->rotation[2], o->second->attach->syncRotation);
@@ -780,7 +784,7 @@ int Manipulation::setIntData(AMX *amx, cell *params)
 								}
 								else if (o->second->attach->player != INVALID_GENERIC_ID)
 								{
-									AMX_NATIVE native = sampgdk::FindNative("AttachPlayerObjectToPlayer");
+									AMX_NATIVE native = Utility::findNative(STREAMER_NATIVE_ATTACH_PLAYER_OBJECT_TO_PLAYER);
 									if (native != NULL)
 									{
 										sampgdk::InvokeNative(native, "dddffffffd", p->first, i->second, o->second->attach->player, o->second->attach->positionOffset[0], o->second->attach->positionOffset[1], o->second->attach->positionOffset[2], o->second->attach->rotation[0], o->second->attach->rotation[1], o->second->attach->rotation[2], 1);
@@ -863,7 +867,9 @@ int Manipulation::setIntData(AMX *amx, cell *params)
 					}
 					case WorldID:
 					{
-						return Utility::setFirstValueInContainer(p->second->worlds, static_cast<int>(params[4])) != 0;
+						bool result = Utility::setFirstValueInContainer(p->second->worlds, static_cast<int>(params[4])) != 0;
+						core->getGrid()->reassignItem(p->second);
+						return result;
 					}
 					default:
 					{
@@ -877,7 +883,9 @@ int Manipulation::setIntData(AMX *amx, cell *params)
 					if (i != core->getData()->internalPickups.end())
 					{
 						sampgdk::DestroyPickup(i->second);
+						core->getData()->reversePickups.erase(i->second);
 						i->second = sampgdk::CreatePickup(p->second->modelID, p->second->type, p->second->position[0], p->second->position[1], p->second->position[2], p->second->worldID);
+						core->getData()->reversePickups.insert(i->second, p->first);
 					}
 				}
 				return 1;
@@ -920,7 +928,9 @@ int Manipulation::setIntData(AMX *amx, cell *params)
 					}
 					case WorldID:
 					{
-						return Utility::setFirstValueInContainer(c->second->worlds, static_cast<int>(params[4])) != 0;
+						bool result = Utility::setFirstValueInContainer(c->second->worlds, static_cast<int>(params[4])) != 0;
+						core->getGrid()->reassignItem(c->second);
+						return result;
 					}
 					default:
 					{
@@ -971,7 +981,9 @@ int Manipulation::setIntData(AMX *amx, cell *params)
 					}
 					case WorldID:
 					{
-						return Utility::setFirstValueInContainer(r->second->worlds, static_cast<int>(params[4])) != 0;
+						bool result = Utility::setFirstValueInContainer(r->second->worlds, static_cast<int>(params[4])) != 0;
+						core->getGrid()->reassignItem(r->second);
+						return result;
 					}
 					default:
 					{
@@ -1046,7 +1058,9 @@ int Manipulation::setIntData(AMX *amx, cell *params)
 					}
 					case WorldID:
 					{
-						return Utility::setFirstValueInContainer(m->second->worlds, static_cast<int>(params[4])) != 0;
+						bool result = Utility::setFirstValueInContainer(m->second->worlds, static_cast<int>(params[4])) != 0;
+						core->getGrid()->reassignItem(m->second);
+						return result;
 					}
 					default:
 					{
@@ -1166,7 +1180,9 @@ int Manipulation::setIntData(AMX *amx, cell *params)
 					}
 					case WorldID:
 					{
-						return Utility::setFirstValueInContainer(t->second->worlds, static_cast<int>(params[4])) != 0;
+						bool result = Utility::setFirstValueInContainer(t->second->worlds, static_cast<int>(params[4])) != 0;
+						core->getGrid()->reassignItem(t->second);
+						return result;
 					}
 					default:
 					{
@@ -1189,7 +1205,9 @@ int Manipulation::setIntData(AMX *amx, cell *params)
 						if (i != p->second.internalTextLabels.end())
 						{
 							sampgdk::DeletePlayer3DTextLabel(p->first, i->second);
+							p->second.reverseTextLabels.erase(i->second);
 							i->second = sampgdk::CreatePlayer3DTextLabel(p->first, t->second->text.c_str(), t->second->color, t->second->position[0], t->second->position[1], t->second->position[2], t->second->drawDistance, t->second->attach ? t->second->attach->player : INVALID_GENERIC_ID, t->second->attach ? t->second->attach->vehicle : INVALID_GENERIC_ID, t->second->testLOS);
+							p->second.reverseTextLabels.insert(i->second, t->first);
 						}
 					}
 				}
@@ -1286,7 +1304,9 @@ int Manipulation::setIntData(AMX *amx, cell *params)
 					}
 					case WorldID:
 					{
-						return Utility::setFirstValueInContainer(a->second->worlds, static_cast<int>(params[4])) != 0;
+						bool result = Utility::setFirstValueInContainer(a->second->worlds, static_cast<int>(params[4])) != 0;
+						core->getGrid()->reassignItem(a->second);
+						return result;
 					}
 					default:
 					{
@@ -1343,7 +1363,9 @@ int Manipulation::setIntData(AMX *amx, cell *params)
 					}
 					case WorldID:
 					{
-						return Utility::setFirstValueInContainer(a->second->worlds, static_cast<int>(params[4])) != 0;
+						bool result = Utility::setFirstValueInContainer(a->second->worlds, static_cast<int>(params[4])) != 0;
+						core->getGrid()->reassignItem(a->second);
+						return result;
 					}
 					default:
 					{
@@ -1357,7 +1379,9 @@ int Manipulation::setIntData(AMX *amx, cell *params)
 					if (i != core->getData()->internalActors.end())
 					{
 						sampgdk::DestroyActor(i->second);
+						core->getData()->reverseActors.erase(i->second);
 						i->second = sampgdk::CreateActor(a->second->modelID, a->second->position[0], a->second->position[1], a->second->position[2], a->second->rotation);
+						core->getData()->reverseActors.insert(i->second, a->first);
 						sampgdk::SetActorInvulnerable(i->second, a->second->invulnerable);
 						sampgdk::SetActorHealth(i->second, a->second->health);
 						sampgdk::SetActorVirtualWorld(i->second, a->second->worldID);
@@ -1441,7 +1465,9 @@ int Manipulation::setIntData(AMX *amx, cell *params)
 					if (i != core->getData()->internalVehicles.end())
 					{
 						sampgdk::DestroyVehicle(i->second);
+						core->getData()->reverseVehicles.erase(i->second);
 						i->second = sampgdk::CreateVehicle(v->second->modelID, v->second->position[0], v->second->position[1], v->second->position[2], v->second->angle, v->second->color[0], v->second->color[1], -1, v->second->spawn.addsiren);
+						core->getData()->reverseVehicles.insert(i->second, v->first);
 						if (i->second == INVALID_VEHICLE_ID)
 						{
 							return 0;
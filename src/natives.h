@@ -43,10 +43,16 @@ namespace Natives
 	// Settings
 	cell AMX_NATIVE_CALL Streamer_GetTickRate(AMX *amx, cell *params);
 	cell AMX_NATIVE_CALL Streamer_SetTickRate(AMX *amx, cell *params);
+	cell AMX_NATIVE_CALL Streamer_GetTickBudget(AMX *amx, cell *params);
+	cell AMX_NATIVE_CALL Streamer_SetTickBudget(AMX *amx, cell *params);
 	cell AMX_NATIVE_CALL Streamer_GetPlayerTickRate(AMX *amx, cell *params);
 	cell AMX_NATIVE_CALL Streamer_SetPlayerTickRate(AMX *amx, cell *params);
+	cell AMX_NATIVE_CALL Streamer_GetPlayerCandidateMargin(AMX *amx, cell *params);
+	cell AMX_NATIVE_CALL Streamer_SetPlayerCandidateMargin(AMX *amx, cell *params);
 	cell AMX_NATIVE_CALL Streamer_GetChunkTickRate(AMX *amx, cell *params);
 	cell AMX_NATIVE_CALL Streamer_SetChunkTickRate(AMX *amx, cell *params);
+	cell AMX_NATIVE_CALL Streamer_GetChunkByteBudget(AMX *amx, cell *params);
+	cell AMX_NATIVE_CALL Streamer_SetChunkByteBudget(AMX *amx, cell *params);
 	cell AMX_NATIVE_CALL Streamer_GetChunkSize(AMX *amx, cell *params);
 	cell AMX_NATIVE_CALL Streamer_SetChunkSize(AMX *amx, cell *params);
 	cell AMX_NATIVE_CALL Streamer_GetMaxItems(AMX *amx, cell *params);
@@ -78,6 +84,8 @@ namespace Natives
 	cell AMX_NATIVE_CALL Streamer_ToggleItemUpdate(AMX *amx, cell *params);
 	cell AMX_NATIVE_CALL Streamer_IsToggleItemUpdate(AMX *amx, cell *params);
 	cell AMX_NATIVE_CALL Streamer_GetLastUpdateTime(AMX *amx, cell *params);
+	cell AMX_NATIVE_CALL Streamer_GetPendingPlayerUpdates(AMX *amx, cell *params);
+	cell AMX_NATIVE_CALL Streamer_GetPlayerChunkBytes(AMX *amx, cell *params);
 	cell AMX_NATIVE_CALL Streamer_Update(AMX *amx, cell *params);
 	cell AMX_NATIVE_CALL Streamer_UpdateEx(AMX *amx, cell *params);
 	// Data Manipulation
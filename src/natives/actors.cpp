@@ -195,7 +195,9 @@ cell AMX_NATIVE_CALL Natives::SetDynamicActorFacingAngle(AMX *amx, cell *params)
 		if (i != core->getData()->internalActors.end())
 		{
 			sampgdk::DestroyActor(i->second);
+			core->getData()->reverseActors.erase(i->second);
 			i->second = sampgdk::CreateActor(a->second->modelID, a->second->position[0], a->second->position[1], a->second->position[2], a->second->rotation);
+			core->getData()->reverseActors.insert(i->second, a->first);
 			sampgdk::SetActorInvulnerable(i->second, a->second->invulnerable);
 			sampgdk::SetActorHealth(i->second, a->second->health);
 			sampgdk::SetActorVirtualWorld(i->second, a->second->worldID);
@@ -286,7 +288,9 @@ cell AMX_NATIVE_CALL Natives::SetDynamicActorInvulnerable(AMX *amx, cell *params
 		if (i != core->getData()->internalActors.end())
 		{
 			sampgdk::DestroyActor(i->second);
+			core->getData()->reverseActors.erase(i->second);
 			i->second = sampgdk::CreateActor(a->second->modelID, a->second->position[0], a->second->position[1], a->second->position[2], a->second->rotation);
+			core->getData()->reverseActors.insert(i->second, a->first);
 			sampgdk::SetActorInvulnerable(i->second, a->second->invulnerable);
 			sampgdk::SetActorHealth(i->second, a->second->health);
 			sampgdk::SetActorVirtualWorld(i->second, a->second->worldID);
@@ -318,11 +322,7 @@ cell AMX_NATIVE_CALL Natives::GetPlayerTargetDynamicActor(AMX *amx, cell *params
 	if (p != core->getData()->players.end())
 	{
 		int actorid = sampgdk::GetPlayerTargetActor(p->second.playerID);
-		for (boost::unordered_map<int, int>::iterator i = core->getData()->internalActors.begin(); i != core->getData()->internalActors.end(); ++i) {
-			if (i->second == actorid) {
-				return i->first;
-			}
-		}
+		return static_cast<cell>(core->getData()->reverseActors.find(actorid));
 	}
 	return 0;
 }
@@ -336,13 +336,7 @@ cell AMX_NATIVE_CALL Natives::GetPlayerCameraTargetDynActor(AMX *amx, cell *para
 		int actorid = sampgdk::GetPlayerCameraTargetActor(p->second.playerID);
 		if (actorid != INVALID_ACTOR_ID)
 		{
-			for (boost::unordered_map<int, int>::iterator i = core->getData()->internalActors.begin(); i != core->getData()->internalActors.end(); ++i)
-			{
-				if (i->second == actorid)
-				{
-					return i->first;
-				}
-			}
+			return static_cast<cell>(core->getData()->reverseActors.find(actorid));
 		}
 	}
 	return 0;
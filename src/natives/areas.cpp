@@ -358,9 +358,11 @@ cell AMX_NATIVE_CALL Natives::IsPointInDynamicArea(AMX *amx, cell *params)
 cell AMX_NATIVE_CALL Natives::IsPointInAnyDynamicArea(AMX *amx, cell *params)
 {
 	CHECK_PARAMS(3, "IsPointInAnyDynamicArea");
-	for (boost::unordered_map<int, Item::SharedArea>::const_iterator a = core->getData()->areas.begin(); a != core->getData()->areas.end(); ++a)
+	std::vector<Item::SharedArea> pointAreas;
+	core->getGrid()->findAreasForPoint(Eigen::Vector2f(amx_ctof(params[1]), amx_ctof(params[2])), pointAreas);
+	for (std::vector<Item::SharedArea>::const_iterator a = pointAreas.begin(); a != pointAreas.end(); ++a)
 	{
-		if (Utility::isPointInArea(Eigen::Vector3f(amx_ctof(params[1]), amx_ctof(params[2]), amx_ctof(params[3])), a->second))
+		if (Utility::isPointInArea(Eigen::Vector3f(amx_ctof(params[1]), amx_ctof(params[2]), amx_ctof(params[3])), *a))
 		{
 			return 1;
 		}
@@ -382,9 +384,11 @@ cell AMX_NATIVE_CALL Natives::IsLineInDynamicArea(AMX *amx, cell *params)
 cell AMX_NATIVE_CALL Natives::IsLineInAnyDynamicArea(AMX *amx, cell *params)
 {
 	CHECK_PARAMS(6, "IsLineInAnyDynamicArea");
-	for (boost::unordered_map<int, Item::SharedArea>::const_iterator a = core->getData()->areas.begin(); a != core->getData()->areas.end(); ++a)
+	std::vector<Item::SharedArea> lineAreas;
+	core->getGrid()->findAreasForLine(Eigen::Vector2f(amx_ctof(params[1]), amx_ctof(params[2])), Eigen::Vector2f(amx_ctof(params[4]), amx_ctof(params[5])), lineAreas);
+	for (std::vector<Item::SharedArea>::const_iterator a = lineAreas.begin(); a != lineAreas.end(); ++a)
 	{
-		if (Utility::doesLineSegmentIntersectArea(Eigen::Vector3f(amx_ctof(params[1]), amx_ctof(params[2]), amx_ctof(params[3])), Eigen::Vector3f(amx_ctof(params[4]), amx_ctof(params[5]), amx_ctof(params[6])), a->second))
+		if (Utility::doesLineSegmentIntersectArea(Eigen::Vector3f(amx_ctof(params[1]), amx_ctof(params[2]), amx_ctof(params[3])), Eigen::Vector3f(amx_ctof(params[4]), amx_ctof(params[5]), amx_ctof(params[6])), *a))
 		{
 			return 1;
 		}
@@ -476,59 +480,56 @@ cell AMX_NATIVE_CALL Natives::GetDynamicAreasForPoint(AMX *amx, cell *params)
 {
 	CHECK_PARAMS(5, "GetDynamicAreasForPoint");
 	std::multimap<float, int> orderedAreas;
-	std::vector<SharedCell> pointCells;
-	core->getGrid()->findMinimalCellsForPoint(Eigen::Vector2f(amx_ctof(params[1]), amx_ctof(params[2])), pointCells);
-	for (std::vector<SharedCell>::const_iterator p = pointCells.begin(); p != pointCells.end(); ++p)
+	std::vector<Item::SharedArea> pointAreas;
+	core->getGrid()->findAreasForPoint(Eigen::Vector2f(amx_ctof(params[1]), amx_ctof(params[2])), pointAreas);
+	for (std::vector<Item::SharedArea>::const_iterator a = pointAreas.begin(); a != pointAreas.end(); ++a)
 	{
-		for (boost::unordered_map<int, Item::SharedArea>::const_iterator a = (*p)->areas.begin(); a != (*p)->areas.end(); ++a)
+		if (Utility::isPointInArea(Eigen::Vector3f(amx_ctof(params[1]), amx_ctof(params[2]), amx_ctof(params[3])), *a))
 		{
-			if (Utility::isPointInArea(Eigen::Vector3f(amx_ctof(params[1]), amx_ctof(params[2]), amx_ctof(params[3])), a->second))
+			boost::variant<Polygon2D, Box2D, Box3D, Eigen::Vector2f, Eigen::Vector3f> position;
+			if ((*a)->attach)
 			{
-				boost::variant<Polygon2D, Box2D, Box3D, Eigen::Vector2f, Eigen::Vector3f> position;
-				if (a->second->attach)
+				position = (*a)->position;
+			}
+			else
+			{
+				position = (*a)->position;
+			}
+			float distance = 0.0f;
+			switch ((*a)->type)
+			{
+				case STREAMER_AREA_TYPE_CIRCLE:
+				case STREAMER_AREA_TYPE_CYLINDER:
 				{
-					position = a->second->position;
+					distance = static_cast<float>(boost::geometry::comparable_distance(Eigen::Vector2f(amx_ctof(params[1]), amx_ctof(params[2])), boost::get<Eigen::Vector2f>(position)));
+					break;
 				}
-				else
+				case STREAMER_AREA_TYPE_SPHERE:
 				{
-					position = a->second->position;
+					distance = static_cast<float>(boost::geometry::comparable_distance(Eigen::Vector3f(amx_ctof(params[1]), amx_ctof(params[2]), amx_ctof(params[3])), boost::get<Eigen::Vector3f>(position)));
+					break;
 				}
-				float distance = 0.0f;
-				switch (a->second->type)
+				case STREAMER_AREA_TYPE_RECTANGLE:
 				{
-					case STREAMER_AREA_TYPE_CIRCLE:
-					case STREAMER_AREA_TYPE_CYLINDER:
-					{
-						distance = static_cast<float>(boost::geometry::comparable_distance(Eigen::Vector2f(amx_ctof(params[1]), amx_ctof(params[2])), boost::get<Eigen::Vector2f>(position)));
-						break;
-					}
-					case STREAMER_AREA_TYPE_SPHERE:
-					{
-						distance = static_cast<float>(boost::geometry::comparable_distance(Eigen::Vector3f(amx_ctof(params[1]), amx_ctof(params[2]), amx_ctof(params[3])), boost::get<Eigen::Vector3f>(position)));
-						break;
-					}
-					case STREAMER_AREA_TYPE_RECTANGLE:
-					{
-						Eigen::Vector2f centroid = boost::geometry::return_centroid<Eigen::Vector2f>(boost::get<Box2D>(position));
-						distance = static_cast<float>(boost::geometry::comparable_distance(Eigen::Vector2f(amx_ctof(params[1]), amx_ctof(params[2])), centroid));
-						break;
-					}
-					case STREAMER_AREA_TYPE_CUBOID:
-					{
-						Eigen::Vector3f centroid = boost::geometry::return_centroid<Eigen::Vector3f>(boost::get<Box3D>(position));
-						distance = static_cast<float>(boost::geometry::comparable_distance(Eigen::Vector3f(amx_ctof(params[1]), amx_ctof(params[2]), amx_ctof(params[3])), centroid));
-						break;
+					Eigen::Vector2f centroid = boost::geometry::return_centroid<Eigen::Vector2f>(boost::get<Box2D>(position));
+					distance = static_cast<float>(boost::geometry::comparable_distance(Eigen::Vector2f(amx_ctof(params[1]), amx_ctof(params[2])), centroid));
+					break;
+				}
+				case STREAMER_AREA_TYPE_CUBOID:
+				{
+					Eigen::Vector3f centroid = boost::geometry::return_centroid<Eigen::Vector3f>(boost::get<Box3D>(position));
+					distance = static_cast<float>(boost::geometry::comparable_distance(Eigen::Vector3f(amx_ctof(params[1]), amx_ctof(params[2]), amx_ctof(params[3])), centroid));
+					break;
 
-					}
-					case STREAMER_AREA_TYPE_POLYGON:
-					{
-						Eigen::Vector2f centroid = boost::geometry::return_centroid<Eigen::Vector2f>(boost::get<Polygon2D>(position));
-						distance = static_cast<float>(boost::geometry::comparable_distance(Eigen::Vector2f(amx_ctof(params[1]), amx_ctof(params[2])), centroid));
-						break;
-					}
 				}
-				orderedAreas.insert(std::pair<float, int>(distance, a->first));
+				case STREAMER_AREA_TYPE_POLYGON:
+				{
+					Eigen::Vector2f centroid = boost::geometry::return_centroid<Eigen::Vector2f>(boost::get<Polygon2D>(position));
+					distance = static_cast<float>(boost::geometry::comparable_distance(Eigen::Vector2f(amx_ctof(params[1]), amx_ctof(params[2])), centroid));
+					break;
+				}
 			}
+			orderedAreas.insert(std::pair<float, int>(distance, (*a)->areaID));
 		}
 	}
 	std::vector<int> finalAreas;
@@ -544,16 +545,13 @@ cell AMX_NATIVE_CALL Natives::GetNumberDynamicAreasForPoint(AMX *amx, cell *para
 {
 	CHECK_PARAMS(3, "GetNumberDynamicAreasForPoint");
 	int areaCount = 0;
-	std::vector<SharedCell> pointCells;
-	core->getGrid()->findMinimalCellsForPoint(Eigen::Vector2f(amx_ctof(params[1]), amx_ctof(params[2])), pointCells);
-	for (std::vector<SharedCell>::const_iterator p = pointCells.begin(); p != pointCells.end(); ++p)
+	std::vector<Item::SharedArea> pointAreas;
+	core->getGrid()->findAreasForPoint(Eigen::Vector2f(amx_ctof(params[1]), amx_ctof(params[2])), pointAreas);
+	for (std::vector<Item::SharedArea>::const_iterator a = pointAreas.begin(); a != pointAreas.end(); ++a)
 	{
-		for (boost::unordered_map<int, Item::SharedArea>::const_iterator a = (*p)->areas.begin(); a != (*p)->areas.end(); ++a)
+		if (Utility::isPointInArea(Eigen::Vector3f(amx_ctof(params[1]), amx_ctof(params[2]), amx_ctof(params[3])), *a))
 		{
-			if (Utility::isPointInArea(Eigen::Vector3f(amx_ctof(params[1]), amx_ctof(params[2]), amx_ctof(params[3])), a->second))
-			{
-				++areaCount;
-			}
+			++areaCount;
 		}
 	}
 	return static_cast<cell>(areaCount);
@@ -563,21 +561,23 @@ cell AMX_NATIVE_CALL Natives::GetDynamicAreasForLine(AMX *amx, cell *params)
 {
 	CHECK_PARAMS(8, "GetDynamicAreasForLine");
 	std::multimap<float, int> orderedAreas;
-	for (boost::unordered_map<int, Item::SharedArea>::const_iterator a = core->getData()->areas.begin(); a != core->getData()->areas.end(); ++a)
+	std::vector<Item::SharedArea> lineAreas;
+	core->getGrid()->findAreasForLine(Eigen::Vector2f(amx_ctof(params[1]), amx_ctof(params[2])), Eigen::Vector2f(amx_ctof(params[4]), amx_ctof(params[5])), lineAreas);
+	for (std::vector<Item::SharedArea>::const_iterator a = lineAreas.begin(); a != lineAreas.end(); ++a)
 	{
-		if (Utility::doesLineSegmentIntersectArea(Eigen::Vector3f(amx_ctof(params[1]), amx_ctof(params[2]), amx_ctof(params[3])), Eigen::Vector3f(amx_ctof(params[4]), amx_ctof(params[5]), amx_ctof(params[6])), a->second))
+		if (Utility::doesLineSegmentIntersectArea(Eigen::Vector3f(amx_ctof(params[1]), amx_ctof(params[2]), amx_ctof(params[3])), Eigen::Vector3f(amx_ctof(params[4]), amx_ctof(params[5]), amx_ctof(params[6])), *a))
 		{
 			boost::variant<Polygon2D, Box2D, Box3D, Eigen::Vector2f, Eigen::Vector3f> position;
-			if (a->second->attach)
+			if ((*a)->attach)
 			{
-				position = a->second->position;
+				position = (*a)->position;
 			}
 			else
 			{
-				position = a->second->position;
+				position = (*a)->position;
 			}
 			float distance = 0.0f;
-			switch (a->second->type)
+			switch ((*a)->type)
 			{
 				case STREAMER_AREA_TYPE_CIRCLE:
 				case STREAMER_AREA_TYPE_CYLINDER:
@@ -610,7 +610,7 @@ cell AMX_NATIVE_CALL Natives::GetDynamicAreasForLine(AMX *amx, cell *params)
 					break;
 				}
 			}
-			orderedAreas.insert(std::pair<float, int>(distance, a->first));
+			orderedAreas.insert(std::pair<float, int>(distance, (*a)->areaID));
 		}
 	}
 	std::vector<int> finalAreas;
@@ -626,9 +626,11 @@ cell AMX_NATIVE_CALL Natives::GetNumberDynamicAreasForLine(AMX *amx, cell *param
 {
 	CHECK_PARAMS(6, "GetNumberDynamicAreasForLine");
 	int areaCount = 0;
-	for (boost::unordered_map<int, Item::SharedArea>::const_iterator a = core->getData()->areas.begin(); a != core->getData()->areas.end(); ++a)
+	std::vector<Item::SharedArea> lineAreas;
+	core->getGrid()->findAreasForLine(Eigen::Vector2f(amx_ctof(params[1]), amx_ctof(params[2])), Eigen::Vector2f(amx_ctof(params[4]), amx_ctof(params[5])), lineAreas);
+	for (std::vector<Item::SharedArea>::const_iterator a = lineAreas.begin(); a != lineAreas.end(); ++a)
 	{
-		if (Utility::doesLineSegmentIntersectArea(Eigen::Vector3f(amx_ctof(params[1]), amx_ctof(params[2]), amx_ctof(params[3])), Eigen::Vector3f(amx_ctof(params[4]), amx_ctof(params[5]), amx_ctof(params[6])), a->second))
+		if (Utility::doesLineSegmentIntersectArea(Eigen::Vector3f(amx_ctof(params[1]), amx_ctof(params[2]), amx_ctof(params[3])), Eigen::Vector3f(amx_ctof(params[4]), amx_ctof(params[5]), amx_ctof(params[6])), *a))
 		{
 			++areaCount;
 		}
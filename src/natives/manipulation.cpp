@@ -44,6 +44,10 @@ cell AMX_NATIVE_CALL Natives::Streamer_GetIntData(AMX *amx, cell *params)
 cell AMX_NATIVE_CALL Natives::Streamer_SetIntData(AMX *amx, cell *params)
 {
 	CHECK_PARAMS(4, "Streamer_SetIntData");
+	if (Manipulation::isConditionData(static_cast<int>(params[3])))
+	{
+		++core->getData()->conditionVersion;
+	}
 	return static_cast<cell>(Manipulation::setIntData(amx, params));
 }
 
@@ -56,6 +60,10 @@ cell AMX_NATIVE_CALL Natives::Streamer_GetArrayData(AMX *amx, cell *params)
 cell AMX_NATIVE_CALL Natives::Streamer_SetArrayData(AMX *amx, cell *params)
 {
 	CHECK_PARAMS(5, "Streamer_SetArrayData");
+	if (Manipulation::isConditionData(static_cast<int>(params[3])))
+	{
+		++core->getData()->conditionVersion;
+	}
 	return static_cast<cell>(Manipulation::setArrayData(amx, params));
 }
 
@@ -68,12 +76,20 @@ cell AMX_NATIVE_CALL Natives::Streamer_IsInArrayData(AMX *amx, cell *params)
 cell AMX_NATIVE_CALL Natives::Streamer_AppendArrayData(AMX *amx, cell *params)
 {
 	CHECK_PARAMS(4, "Streamer_AppendArrayData");
+	if (Manipulation::isConditionData(static_cast<int>(params[3])))
+	{
+		++core->getData()->conditionVersion;
+	}
 	return static_cast<cell>(Manipulation::appendArrayData(amx, params));
 }
 
 cell AMX_NATIVE_CALL Natives::Streamer_RemoveArrayData(AMX *amx, cell *params)
 {
 	CHECK_PARAMS(4, "Streamer_RemoveArrayData");
+	if (Manipulation::isConditionData(static_cast<int>(params[3])))
+	{
+		++core->getData()->conditionVersion;
+	}
 	return static_cast<cell>(Manipulation::removeArrayData(amx, params));
 }
 
@@ -19,6 +19,7 @@
 #include "../core.h"
 #include "../utility.h"
 
+#include <boost/chrono.hpp>
 #include <boost/geometry.hpp>
 #include <boost/geometry/geometries/geometries.hpp>
 #include <boost/intrusive_ptr.hpp>
@@ -48,6 +49,10 @@ cell AMX_NATIVE_CALL Natives::Streamer_GetDistanceToItem(AMX *amx, cell *params)
 				}
 				else
 				{
+					if (o->second->move)
+					{
+						core->getStreamer()->updateObjectMove(o->second, boost::chrono::steady_clock::now());
+					}
 					position = o->second->position;
 				}
 				break;
@@ -226,6 +231,7 @@ cell AMX_NATIVE_CALL Natives::Streamer_GetDistanceToItem(AMX *amx, cell *params)
 cell AMX_NATIVE_CALL Natives::Streamer_ToggleItem(AMX *amx, cell *params)
 {
 	CHECK_PARAMS(4, "Streamer_ToggleItem");
+	++core->getData()->conditionVersion;
 	switch (static_cast<int>(params[2]))
 	{
 		case STREAMER_TYPE_OBJECT:
@@ -495,6 +501,7 @@ cell AMX_NATIVE_CALL Natives::Streamer_IsToggleItem(AMX *amx, cell *params)
 cell AMX_NATIVE_CALL Natives::Streamer_ToggleAllItems(AMX *amx, cell *params)
 {
 	CHECK_PARAMS(5, "Streamer_ToggleAllItems");
+	++core->getData()->conditionVersion;
 	boost::unordered_set<int> exceptions;
 	Utility::convertArrayToContainer(amx, params[4], params[5], exceptions);
 	switch (static_cast<int>(params[2]))
@@ -704,14 +711,7 @@ cell AMX_NATIVE_CALL Natives::Streamer_GetItemInternalID(AMX *amx, cell *params)
 		}
 		case STREAMER_TYPE_VEHICLE:
 		{
-			for (boost::unordered_map<int, int>::iterator i = core->getData()->internalVehicles.begin(); i != core->getData()->internalVehicles.end(); ++i)
-			{
-				if (i->second == static_cast<int>(params[3]))
-				{
-					return i->first;
-				}
-			}
-			return 0;
+			return static_cast<cell>(core->getData()->reverseVehicles.find(static_cast<int>(params[3])));
 		}
 	}
 	boost::unordered_map<int, Player>::iterator p = core->getData()->players.find(static_cast<int>(params[1]));
@@ -787,36 +787,15 @@ cell AMX_NATIVE_CALL Natives::Streamer_GetItemStreamerID(AMX *amx, cell *params)
 	{
 		case STREAMER_TYPE_PICKUP:
 		{
-			for (boost::unordered_map<int, int>::iterator i = core->getData()->internalPickups.begin(); i != core->getData()->internalPickups.end(); ++i)
-			{
-				if (i->second == static_cast<int>(params[3]))
-				{
-					return i->first;
-				}
-			}
-			return 0;
+			return static_cast<cell>(core->getData()->reversePickups.find(static_cast<int>(params[3])));
 		}
 		case STREAMER_TYPE_ACTOR:
 		{
-			for (boost::unordered_map<int, int>::iterator i = core->getData()->internalActors.begin(); i != core->getData()->internalActors.end(); ++i)
-			{
-				if (i->second == static_cast<int>(params[3]))
-				{
-					return i->first;
-				}
-			}
-			return 0;
+			return static_cast<cell>(core->getData()->reverseActors.find(static_cast<int>(params[3])));
 		}
 		case STREAMER_TYPE_VEHICLE:
 		{
-			for (boost::unordered_map<int, int>::iterator i = core->getData()->internalVehicles.begin(); i != core->getData()->internalVehicles.end(); ++i)
-			{
-				if (i->second == static_cast<int>(params[3]))
-				{
-					return i->first;
-				}
-			}
-			return 0;
+			return static_cast<cell>(core->getData()->reverseVehicles.find(static_cast<int>(params[3])));
 		}
 	}
 	boost::unordered_map<int, Player>::iterator p = core->getData()->players.find(static_cast<int>(params[1]));
@@ -826,14 +805,7 @@ cell AMX_NATIVE_CALL Natives::Streamer_GetItemStreamerID(AMX *amx, cell *params)
 		{
 			case STREAMER_TYPE_OBJECT:
 			{
-				for (boost::unordered_map<int, int>::iterator i = p->second.internalObjects.begin(); i != p->second.internalObjects.end(); ++i)
-				{
-					if (i->second == static_cast<int>(params[3]))
-					{
-						return i->first;
-					}
-				}
-				return 0;
+				return static_cast<cell>(p->second.reverseObjects.find(static_cast<int>(params[3])));
 			}
 			case STREAMER_TYPE_CP:
 			{
@@ -864,14 +836,7 @@ cell AMX_NATIVE_CALL Natives::Streamer_GetItemStreamerID(AMX *amx, cell *params)
 			}
 			case STREAMER_TYPE_3D_TEXT_LABEL:
 			{
-				for (boost::unordered_map<int, int>::iterator i = p->second.internalTextLabels.begin(); i != p->second.internalTextLabels.end(); ++i)
-				{
-					if (i->second == static_cast<int>(params[3]))
-					{
-						return i->first;
-					}
-				}
-				return 0;
+				return static_cast<cell>(p->second.reverseTextLabels.find(static_cast<int>(params[3])));
 			}
 			case STREAMER_TYPE_AREA:
 			{
@@ -1006,6 +971,11 @@ cell AMX_NATIVE_CALL Natives::Streamer_DestroyAllVisibleItems(AMX *amx, cell *pa
 				if (serverWide || (p != core->getData()->pickups.end() && p->second->amx == amx))
 				{
 					sampgdk::DestroyPickup(i->second);
+					if (p != core->getData()->pickups.end() && core->getData()->pickupReferences.find(i->first) != core->getData()->pickupReferences.end())
+					{
+						core->getData()->discoveredPickups.insert(*p);
+					}
+					core->getData()->reversePickups.erase(i->second);
 					i = core->getData()->internalPickups.erase(i);
 				}
 				else
@@ -1024,6 +994,11 @@ cell AMX_NATIVE_CALL Natives::Streamer_DestroyAllVisibleItems(AMX *amx, cell *pa
 				if (serverWide || (a != core->getData()->actors.end() && a->second->amx == amx))
 				{
 					sampgdk::DestroyActor(i->second);
+					if (a != core->getData()->actors.end() && core->getData()->actorReferences.find(i->first) != core->getData()->actorReferences.end())
+					{
+						core->getData()->discoveredActors.insert(*a);
+					}
+					core->getData()->reverseActors.erase(i->second);
 					i = core->getData()->internalActors.erase(i);
 				}
 				else
@@ -1036,12 +1011,17 @@ cell AMX_NATIVE_CALL Natives::Streamer_DestroyAllVisibleItems(AMX *amx, cell *pa
 		case STREAMER_TYPE_VEHICLE:
 		{
 			boost::unordered_map<int, int>::iterator p = core->getData()->internalVehicles.begin();
-			while (p != core->getData()->internalPickups.end())
+			while (p != core->getData()->internalVehicles.end())
 			{
 				boost::unordered_map<int, Item::SharedVehicle>::iterator q = core->getData()->vehicles.find(p->first);
 				if (serverWide || (q != core->getData()->vehicles.end() && q->second->amx == amx))
 				{
 					sampgdk::DestroyVehicle(p->second);
+					if (q != core->getData()->vehicles.end() && core->getData()->vehicleReferences.find(p->first) != core->getData()->vehicleReferences.end())
+					{
+						core->getData()->discoveredVehicles.insert(*q);
+					}
+					core->getData()->reverseVehicles.erase(p->second);
 					p = core->getData()->internalVehicles.erase(p);
 				}
 				else
@@ -1066,6 +1046,8 @@ cell AMX_NATIVE_CALL Natives::Streamer_DestroyAllVisibleItems(AMX *amx, cell *pa
 					if (serverWide || (o != core->getData()->objects.end() && o->second->amx == amx))
 					{
 						sampgdk::DestroyPlayerObject(p->first, i->second);
+						p->second.streamedObjects.erase(i->first);
+						p->second.reverseObjects.erase(i->second);
 						i = p->second.internalObjects.erase(i);
 					}
 					else
@@ -1114,6 +1096,7 @@ cell AMX_NATIVE_CALL Natives::Streamer_DestroyAllVisibleItems(AMX *amx, cell *pa
 					if (serverWide || (m != core->getData()->mapIcons.end() && m->second->amx == amx))
 					{
 						sampgdk::RemovePlayerMapIcon(p->first, i->second);
+						p->second.streamedMapIcons.erase(i->first);
 						i = p->second.internalMapIcons.erase(i);
 					}
 					else
@@ -1132,6 +1115,8 @@ cell AMX_NATIVE_CALL Natives::Streamer_DestroyAllVisibleItems(AMX *amx, cell *pa
 					if (serverWide || (t != core->getData()->textLabels.end() && t->second->amx == amx))
 					{
 						sampgdk::DeletePlayer3DTextLabel(p->first, i->second);
+						p->second.streamedTextLabels.erase(i->first);
+						p->second.reverseTextLabels.erase(i->second);
 						i = p->second.internalTextLabels.erase(i);
 					}
 					else
@@ -1150,6 +1135,7 @@ cell AMX_NATIVE_CALL Natives::Streamer_DestroyAllVisibleItems(AMX *amx, cell *pa
 					if (serverWide || (a != core->getData()->areas.end() && a->second->amx == amx))
 					{
 						i = p->second.internalAreas.erase(i);
+						++p->second.internalAreasVersion;
 					}
 					else
 					{
@@ -1660,11 +1646,12 @@ cell AMX_NATIVE_CALL Natives::Streamer_GetNearbyItems(AMX *amx, cell *params)
 	float range = amx_ctof(params[7]) * amx_ctof(params[7]);
 	std::multimap<float, int> orderedItems;
 	std::vector<SharedCell> pointCells;
-	core->getGrid()->findMinimalCellsForPoint(position2D, pointCells);
+	core->getGrid()->findCellsForPoint(position2D, amx_ctof(params[7]), pointCells);
 	switch (static_cast<int>(params[4]))
 	{
 		case STREAMER_TYPE_OBJECT:
 		{
+			boost::chrono::steady_clock::time_point currentTime = boost::chrono::steady_clock::now();
 			for (std::vector<SharedCell>::const_iterator p = pointCells.begin(); p != pointCells.end(); ++p)
 			{
 				for (boost::unordered_map<int, Item::SharedObject>::const_iterator o = (*p)->objects.begin(); o != (*p)->objects.end(); ++o)
@@ -1676,6 +1663,10 @@ cell AMX_NATIVE_CALL Natives::Streamer_GetNearbyItems(AMX *amx, cell *params)
 					}
 					else
 					{
+						if (o->second->move)
+						{
+							core->getStreamer()->updateObjectMove(o->second, currentTime);
+						}
 						distance = static_cast<float>(boost::geometry::comparable_distance(position3D, o->second->position));
 					}
 					if (distance < range)
@@ -1873,6 +1864,7 @@ cell AMX_NATIVE_CALL Natives::Streamer_GetAllVisibleItems(AMX *amx, cell *params
 		{
 			case STREAMER_TYPE_OBJECT:
 			{
+				boost::chrono::steady_clock::time_point currentTime = boost::chrono::steady_clock::now();
 				for (boost::unordered_map<int, int>::iterator i = p->second.internalObjects.begin(); i != p->second.internalObjects.end(); ++i)
 				{
 					boost::unordered_map<int, Item::SharedObject>::iterator o = core->getData()->objects.find(i->first);
@@ -1885,6 +1877,10 @@ cell AMX_NATIVE_CALL Natives::Streamer_GetAllVisibleItems(AMX *amx, cell *params
 						}
 						else
 						{
+							if (o->second->move)
+							{
+								core->getStreamer()->updateObjectMove(o->second, currentTime);
+							}
 							distance = static_cast<float>(boost::geometry::comparable_distance(p->second.position, o->second->position));
 						}
 						orderedItems.insert(std::pair<float, int>(distance, o->first));
@@ -2085,6 +2081,10 @@ cell AMX_NATIVE_CALL Natives::Streamer_SetItemOffset(AMX *amx, cell *params)
 			if (o != core->getData()->objects.end())
 			{
 				o->second->positionOffset = Eigen::Vector3f(amx_ctof(params[3]), amx_ctof(params[4]), amx_ctof(params[5]));
+				if (o->second->cell)
+				{
+					++o->second->cell->version;
+				}
 				return 1;
 			}
 			break;
@@ -2125,6 +2125,10 @@ cell AMX_NATIVE_CALL Natives::Streamer_SetItemOffset(AMX *amx, cell *params)
 			if (m != core->getData()->mapIcons.end())
 			{
 				m->second->positionOffset = Eigen::Vector3f(amx_ctof(params[3]), amx_ctof(params[4]), amx_ctof(params[5]));
+				if (m->second->cell)
+				{
+					++m->second->cell->version;
+				}
 				return 1;
 			}
 			break;
@@ -2135,6 +2139,10 @@ cell AMX_NATIVE_CALL Natives::Streamer_SetItemOffset(AMX *amx, cell *params)
 			if (t != core->getData()->textLabels.end())
 			{
 				t->second->positionOffset = Eigen::Vector3f(amx_ctof(params[3]), amx_ctof(params[4]), amx_ctof(params[5]));
+				if (t->second->cell)
+				{
+					++t->second->cell->version;
+				}
 				return 1;
 			}
 			break;
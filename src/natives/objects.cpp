@@ -95,7 +95,7 @@ cell AMX_NATIVE_CALL Natives::GetDynamicObjectPos(AMX *amx, cell *params)
 	{
 		if (o->second->move)
 		{
-			core->getStreamer()->processActiveItems();
+			core->getStreamer()->updateObjectMove(o->second, boost::chrono::steady_clock::now());
 		}
 		Utility::storeFloatInNative(amx, params[2], o->second->position[0]);
 		Utility::storeFloatInNative(amx, params[3], o->second->position[1]);
@@ -128,6 +128,13 @@ cell AMX_NATIVE_CALL Natives::SetDynamicObjectPos(AMX *amx, cell *params)
 				core->getGrid()->removeObject(o->second, true);
 			}
 		}
+		else if (position[2] != o->second->position[2])
+		{
+			if (o->second->cell)
+			{
+				++o->second->cell->version;
+			}
+		}
 		if (o->second->move)
 		{
 			o->second->move->duration = static_cast<int>((static_cast<float>(boost::geometry::distance(o->second->move->position.get<0>(), o->second->position) / o->second->move->speed) * 1000.0f));
@@ -139,6 +146,7 @@ cell AMX_NATIVE_CALL Natives::SetDynamicObjectPos(AMX *amx, cell *params)
 				o->second->move->rotation.get<2>() = (o->second->move->rotation.get<0>() - o->second->rotation) / static_cast<float>(o->second->move->duration);
 			}
 			o->second->move->time = boost::chrono::steady_clock::now();
+			core->getStreamer()->scheduleObjectMove(o->second);
 		}
 		return 1;
 	}
@@ -153,7 +161,7 @@ cell AMX_NATIVE_CALL Natives::GetDynamicObjectRot(AMX *amx, cell *params)
 	{
 		if (o->second->move)
 		{
-			core->getStreamer()->processActiveItems();
+			core->getStreamer()->updateObjectMove(o->second, boost::chrono::steady_clock::now());
 		}
 		Utility::storeFloatInNative(amx, params[2], o->second->rotation[0]);
 		Utility::storeFloatInNative(amx, params[3], o->second->rotation[1]);
@@ -239,6 +247,10 @@ cell AMX_NATIVE_CALL Natives::MoveDynamicObject(AMX *amx, cell *params)
 		}
 		Eigen::Vector3f position(amx_ctof(params[2]), amx_ctof(params[3]), amx_ctof(params[4]));
 		Eigen::Vector3f rotation(amx_ctof(params[6]), amx_ctof(params[7]), amx_ctof(params[8]));
+		if (o->second->move)
+		{
+			core->getStreamer()->updateObjectMove(o->second, boost::chrono::steady_clock::now());
+		}
 		o->second->move = boost::intrusive_ptr<Item::Object::Move>(new Item::Object::Move);
 		o->second->move->duration = static_cast<int>((static_cast<float>(boost::geometry::distance(position, o->second->position) / amx_ctof(params[5])) * 1000.0f));
 		o->second->move->position.get<0>() = position;
@@ -261,7 +273,14 @@ cell AMX_NATIVE_CALL Natives::MoveDynamicObject(AMX *amx, cell *params)
 				sampgdk::MovePlayerObject(p->first, i->second, o->second->move->position.get<0>()[0], o->second->move->position.get<0>()[1], o->second->move->position.get<0>()[2], o->second->move->speed, o->second->move->rotation.get<0>()[0], o->second->move->rotation.get<0>()[1], o->second->move->rotation.get<0>()[2]);
 			}
 		}
-		core->getStreamer()->movingObjects.insert(o->second);
+		if (o->second->cell)
+		{
+			core->getGrid()->removeObject(o->second, true);
+		}
+		else
+		{
+			core->getStreamer()->scheduleObjectMove(o->second);
+		}
 		return static_cast<cell>(o->second->move->duration);
 	}
 	return 0;
@@ -283,8 +302,12 @@ cell AMX_NATIVE_CALL Natives::StopDynamicObject(AMX *amx, cell *params)
 					sampgdk::StopPlayerObject(p->first, i->second);
 				}
 			}
+			core->getStreamer()->updateObjectMove(o->second, boost::chrono::steady_clock::now());
 			o->second->move.reset();
-			core->getStreamer()->movingObjects.erase(o->second);
+			if (o->second->cell)
+			{
+				core->getGrid()->removeObject(o->second, true);
+			}
 			return 1;
 		}
 	}
@@ -343,7 +366,7 @@ cell AMX_NATIVE_CALL Natives::AttachCameraToDynamicObject(AMX *amx, cell *params
 cell AMX_NATIVE_CALL Natives::AttachDynamicObjectToObject(AMX *amx, cell *params)
 {
 	CHECK_PARAMS(9, "AttachDynamicObjectToObject");
-	if (sampgdk::FindNative("SetPlayerGravity") == NULL)
+	if (Utility::findNative(STREAMER_NATIVE_SET_PLAYER_GRAVITY) == NULL)
 	{
 		Utility::logError("AttachDynamicObjectToObject: YSF plugin must be loaded to attach objects to objects.");
 		return 0;
@@ -371,7 +394,7 @@ cell AMX_NATIVE_CALL Natives::AttachDynamicObjectToObject(AMX *amx, cell *params
 				boost::unordered_map<int, int>::iterator j = p->second.internalObjects.find(o->second->attach->object);
 				if (j != p->second.internalObjects.end())
 				{
-					AMX_NATIVE native = sampgdk::FindNative("AttachPlayerObjectToObject");
+					AMX_NATIVE native = Utility::findNative(STREAMER_NATIVE_ATTACH_PLAYER_OBJECT_TO_OBJECT);
 					if (native != NULL)
 					{
 						sampgdk::InvokeNative(native, "dddffffffb", p->first, i->second, j->second, o->second->attach->positionOffset[0], o->second->attach->positionOffset[1], o->second->attach->positionOffset[2], o->second->attach->rotation[0], o->second->attach->rotation[1], o->second->attach->rotation[2], o->second->attach->syncRotation);
@@ -421,7 +444,7 @@ cell AMX_NATIVE_CALL Natives::AttachDynamicObjectToObject(AMX *amx, cell *params
 cell AMX_NATIVE_CALL Natives::AttachDynamicObjectToPlayer(AMX *amx, cell *params)
 {
 	CHECK_PARAMS(8, "AttachDynamicObjectToPlayer");
-	if (sampgdk::FindNative("SetPlayerGravity") == NULL)
+	if (Utility::findNative(STREAMER_NATIVE_SET_PLAYER_GRAVITY) == NULL)
 	{
 		Utility::logError("AttachDynamicObjectToPlayer: YSF plugin must be loaded to attach objects to players.");
 		return 0;
@@ -445,7 +468,7 @@ cell AMX_NATIVE_CALL Natives::AttachDynamicObjectToPlayer(AMX *amx, cell *params
 			boost::unordered_map<int, int>::iterator i = p->second.internalObjects.find(o->first);
 			if (i != p->second.internalObjects.end())
 			{
-				AMX_NATIVE native = sampgdk::FindNative("AttachPlayerObjectToPlayer");
+				AMX_NATIVE native = Utility::findNative(STREAMER_NATIVE_ATTACH_PLAYER_OBJECT_TO_PLAYER);
 				if (native != NULL)
 				{
 					sampgdk::InvokeNative(native, "dddffffffd", p->first, i->second, o->second->attach->player, o->second->attach->positionOffset[0], o->second->attach->positionOffset[1], o->second->attach->positionOffset[2], o->second->attach->rotation[0], o->second->attach->rotation[1], o->second->attach->rotation[2], 0);
@@ -733,13 +756,7 @@ cell AMX_NATIVE_CALL Natives::GetPlayerCameraTargetDynObject(AMX *amx, cell *par
 		int objectid = sampgdk::GetPlayerCameraTargetObject(p->second.playerID);
 		if (objectid != INVALID_OBJECT_ID)
 		{
-			for (boost::unordered_map<int, int>::iterator i = p->second.internalObjects.begin(); i != p->second.internalObjects.end(); ++i)
-			{
-				if (i->second == objectid)
-				{
-					return i->first;
-				}
-			}
+			return static_cast<cell>(p->second.reverseObjects.find(objectid));
 		}
 	}
 	return 0;
@@ -21,6 +21,8 @@
 
 #include <boost/scoped_ptr.hpp>
 
+#include <algorithm>
+
 cell AMX_NATIVE_CALL Natives::Streamer_GetTickRate(AMX *amx, cell *params)
 {
 	return static_cast<cell>(core->getStreamer()->getTickRate());
@@ -32,6 +34,22 @@ cell AMX_NATIVE_CALL Natives::Streamer_SetTickRate(AMX *amx, cell *params)
 	return static_cast<cell>(core->getStreamer()->setTickRate(static_cast<std::size_t>(params[1])));
 }
 
+cell AMX_NATIVE_CALL Natives::Streamer_GetTickBudget(AMX *amx, cell *params)
+{
+	return static_cast<cell>(core->getStreamer()->getTickBudget());
+}
+
+cell AMX_NATIVE_CALL Natives::Streamer_SetTickBudget(AMX *amx, cell *params)
+{
+	CHECK_PARAMS(1, "Streamer_SetTickBudget");
+	if (static_cast<int>(params[1]) >= 0)
+	{
+		core->getStreamer()->setTickBudget(static_cast<std::size_t>(params[1]));
+		return 1;
+	}
+	return 0;
+}
+
 cell AMX_NATIVE_CALL Natives::Streamer_GetPlayerTickRate(AMX *amx, cell *params)
 {
 	CHECK_PARAMS(1, "Streamer_GetPlayerTickRate");
@@ -55,6 +73,32 @@ cell AMX_NATIVE_CALL Natives::Streamer_SetPlayerTickRate(AMX *amx, cell *params)
 	return 0;
 }
 
+cell AMX_NATIVE_CALL Natives::Streamer_GetPlayerCandidateMargin(AMX *amx, cell *params)
+{
+	CHECK_PARAMS(2, "Streamer_GetPlayerCandidateMargin");
+	boost::unordered_map<int, Player>::iterator p = core->getData()->players.find(static_cast<int>(params[1]));
+	if (p != core->getData()->players.end())
+	{
+		Utility::storeFloatInNative(amx, params[2], p->second.candidateMargin);
+		return 1;
+	}
+	return 0;
+}
+
+cell AMX_NATIVE_CALL Natives::Streamer_SetPlayerCandidateMargin(AMX *amx, cell *params)
+{
+	CHECK_PARAMS(2, "Streamer_SetPlayerCandidateMargin");
+	boost::unordered_map<int, Player>::iterator p = core->getData()->players.find(static_cast<int>(params[1]));
+	if (p != core->getData()->players.end())
+	{
+		p->second.candidateMargin = std::max(amx_ctof(params[2]), 0.0f);
+		p->second.candidatePosition = p->second.position;
+		++p->second.candidateUpdate;
+		return 1;
+	}
+	return 0;
+}
+
 cell AMX_NATIVE_CALL Natives::Streamer_GetChunkTickRate(AMX *amx, cell *params)
 {
 	CHECK_PARAMS(2, "Streamer_GetChunkTickRate");
@@ -67,6 +111,18 @@ cell AMX_NATIVE_CALL Natives::Streamer_SetChunkTickRate(AMX *amx, cell *params)
 	return static_cast<cell>(Utility::setChunkTickRate(static_cast<int>(params[1]), static_cast<std::size_t>(params[2]), static_cast<std::size_t>(params[3])) != 0);
 }
 
+cell AMX_NATIVE_CALL Natives::Streamer_GetChunkByteBudget(AMX *amx, cell *params)
+{
+	CHECK_PARAMS(2, "Streamer_GetChunkByteBudget");
+	return static_cast<cell>(Utility::getChunkByteBudget(static_cast<int>(params[1]), static_cast<int>(params[2])));
+}
+
+cell AMX_NATIVE_CALL Natives::Streamer_SetChunkByteBudget(AMX *amx, cell *params)
+{
+	CHECK_PARAMS(3, "Streamer_SetChunkByteBudget");
+	return static_cast<cell>(Utility::setChunkByteBudget(static_cast<int>(params[1]), static_cast<std::size_t>(std::max(params[2], static_cast<cell>(0))), static_cast<int>(params[3])) != 0);
+}
+
 cell AMX_NATIVE_CALL Natives::Streamer_GetChunkSize(AMX *amx, cell *params)
 {
 	CHECK_PARAMS(1, "Streamer_GetChunkSize");
@@ -488,6 +544,7 @@ cell AMX_NATIVE_CALL Natives::Streamer_IsToggleItemStatic(AMX *amx, cell *params
 cell AMX_NATIVE_CALL Natives::Streamer_ToggleItemInvAreas(AMX *amx, cell *params)
 {
 	CHECK_PARAMS(3, "Streamer_ToggleItemInvAreas");
+	++core->getData()->conditionVersion;
 	switch (static_cast<int>(params[1]))
 	{
 		case STREAMER_TYPE_OBJECT:
@@ -114,6 +114,36 @@ cell AMX_NATIVE_CALL Natives::Streamer_GetLastUpdateTime(AMX *amx, cell *params)
 	return 1;
 }
 
+cell AMX_NATIVE_CALL Natives::Streamer_GetPendingPlayerUpdates(AMX *amx, cell *params)
+{
+	return static_cast<cell>(core->getStreamer()->getPendingPlayerUpdates());
+}
+
+cell AMX_NATIVE_CALL Natives::Streamer_GetPlayerChunkBytes(AMX *amx, cell *params)
+{
+	CHECK_PARAMS(2, "Streamer_GetPlayerChunkBytes");
+	boost::unordered_map<int, Player>::iterator p = core->getData()->players.find(static_cast<int>(params[1]));
+	if (p != core->getData()->players.end())
+	{
+		switch (static_cast<int>(params[2]))
+		{
+			case STREAMER_TYPE_OBJECT:
+			{
+				return static_cast<cell>(p->second.chunkBytes[STREAMER_TYPE_OBJECT]);
+			}
+			case STREAMER_TYPE_MAP_ICON:
+			{
+				return static_cast<cell>(p->second.chunkBytes[STREAMER_TYPE_MAP_ICON]);
+			}
+			case STREAMER_TYPE_3D_TEXT_LABEL:
+			{
+				return static_cast<cell>(p->second.chunkBytes[STREAMER_TYPE_3D_TEXT_LABEL]);
+			}
+		}
+	}
+	return 0;
+}
+
 cell AMX_NATIVE_CALL Natives::Streamer_Update(AMX *amx, cell *params)
 {
 	CHECK_PARAMS(2, "Streamer_Update");
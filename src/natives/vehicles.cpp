@@ -491,7 +491,7 @@ cell AMX_NATIVE_CALL Natives::SetDynamicVehicleToRespawn(AMX *amx, cell *params)
 			for (std::set<AMX*>::iterator a = core->getData()->interfaces.begin(); a != core->getData()->interfaces.end(); ++a)
 			{
 				int amxIndex = 0;
-				if (!amx_FindPublic(*a, "OnDynamicVehicleSpawn", &amxIndex))
+				if (Utility::findPublic(*a, STREAMER_CALLBACK_ON_DYNAMIC_VEHICLE_SPAWN, amxIndex))
 				{
 					amx_Push(*a, static_cast<cell>(v->first));
 					amx_Exec(*a, NULL, amxIndex);
@@ -742,14 +742,7 @@ cell AMX_NATIVE_CALL Natives::GetDynamicVehicleTrailer(AMX *amx, cell *params)
 		if (i != core->getData()->internalVehicles.end())
 		{
 			int trailerid = sampgdk::GetVehicleTrailer(i->second);
-			for (boost::unordered_map<int, int>::iterator j = core->getData()->internalVehicles.begin(); j != core->getData()->internalVehicles.end(); ++j)
-			{
-				if (j->second == trailerid)
-				{
-					return j->first;
-				}
-			}
-			return 0;
+			return static_cast<cell>(core->getData()->reverseVehicles.find(trailerid));
 		}
 		return 0;
 	}
@@ -987,13 +980,7 @@ cell AMX_NATIVE_CALL Natives::GetPlayerSurfingDynamicVehID(AMX *amx, cell *param
 	int internalid = sampgdk::GetPlayerSurfingVehicleID(static_cast<int>(params[1]));
 	if (internalid)
 	{
-		for (boost::unordered_map<int, int>::iterator i = core->getData()->internalVehicles.begin(); i != core->getData()->internalVehicles.end(); ++i)
-		{
-			if (i->second == internalid)
-			{
-				return i->first;
-			}
-		}
+		return static_cast<cell>(core->getData()->reverseVehicles.find(internalid));
 	}
 	return 0;
 }
@@ -1079,17 +1066,21 @@ cell AMX_NATIVE_CALL Natives::PutPlayerInDynamicVehicle(AMX *amx, cell *params)
 					sampgdk::SetVehicleParamsCarWindows(internalID, v->second->params.carwindows.driver, v->second->params.carwindows.passenger, v->second->params.carwindows.backleft, v->second->params.carwindows.backright);
 				}
 				sampgdk::PutPlayerInVehicle(playerid, internalID, seatid);
+				Utility::setPlayerDrivenVehicle(playerid, seatid == 0 ? internalID : INVALID_VEHICLE_ID);
 				core->getData()->internalVehicles.insert(std::make_pair(v->first, internalID));
+				core->getData()->reverseVehicles.insert(internalID, v->first);
 			}
 			else
 			{
 				sampgdk::PutPlayerInVehicle(playerid, i->second, seatid);
+				Utility::setPlayerDrivenVehicle(playerid, seatid == 0 ? i->second : INVALID_VEHICLE_ID);
 			}
 
 			if (!v->second->touched)
 			{
 				v->second->touched = true;
 				v->second->used = true;
+				core->getStreamer()->scheduleVehicleRespawn(v->second);
 			}
 			core->getStreamer()->movingVehicles.insert(v->second);
 
@@ -1106,13 +1097,7 @@ cell AMX_NATIVE_CALL Natives::GetPlayerDynamicVehicleID(AMX *amx, cell *params)
 	int internalid = sampgdk::GetPlayerVehicleID(static_cast<int>(params[1]));
 	if (internalid)
 	{
-		for (boost::unordered_map<int, int>::iterator i = core->getData()->internalVehicles.begin(); i != core->getData()->internalVehicles.end(); ++i)
-		{
-			if (i->second == internalid)
-			{
-				return i->first;
-			}
-		}
+		return static_cast<cell>(core->getData()->reverseVehicles.find(internalid));
 	}
 	return 0;
 }
@@ -1123,13 +1108,8 @@ cell AMX_NATIVE_CALL Natives::IsPlayerInDynamicVehicle(AMX *amx, cell *params)
 	int internalid = sampgdk::GetPlayerVehicleID(static_cast<int>(params[1]));
 	if (internalid)
 	{
-		for (boost::unordered_map<int, int>::iterator i = core->getData()->internalVehicles.begin(); i != core->getData()->internalVehicles.end(); ++i)
-		{
-			if (i->second == internalid)
-			{
-				return i->first == static_cast<int>(params[2]);
-			}
-		}
+		int vehicleid = core->getData()->reverseVehicles.find(internalid);
+		return vehicleid != INVALID_STREAMER_ID && vehicleid == static_cast<int>(params[2]);
 	}
 	return 0;
 }
@@ -1140,13 +1120,7 @@ cell AMX_NATIVE_CALL Natives::IsPlayerInAnyDynamicVehicle(AMX *amx, cell *params
 	int internalid = sampgdk::GetPlayerVehicleID(static_cast<int>(params[1]));
 	if (internalid)
 	{
-		for (boost::unordered_map<int, int>::iterator i = core->getData()->internalVehicles.begin(); i != core->getData()->internalVehicles.end(); ++i)
-		{
-			if (i->second == internalid)
-			{
-				return 1;
-			}
-		}
+		return core->getData()->reverseVehicles.find(internalid) != INVALID_STREAMER_ID;
 	}
 	return 0;
 }
@@ -29,9 +29,17 @@ Player::Player(int id)
 {
 	activeCheckpoint = 0;
 	activeRaceCheckpoint = 0;
-	checkedPickups = false;
-	checkedActors = false;
-	checkedVehicles = false;
+	cachedCellConditions = boost::make_tuple(0, 0, -1, -1);
+	cachedCellUpdate = 0;
+	candidatePosition.setZero();
+	candidateMargin = 0.0f;
+	candidateUpdate = 1;
+	chunkByteBudget[STREAMER_TYPE_OBJECT] = core->getData()->getGlobalChunkByteBudget(STREAMER_TYPE_OBJECT);
+	chunkByteBudget[STREAMER_TYPE_MAP_ICON] = core->getData()->getGlobalChunkByteBudget(STREAMER_TYPE_MAP_ICON);
+	chunkByteBudget[STREAMER_TYPE_3D_TEXT_LABEL] = core->getData()->getGlobalChunkByteBudget(STREAMER_TYPE_3D_TEXT_LABEL);
+	chunkBytes[STREAMER_TYPE_OBJECT] = 0;
+	chunkBytes[STREAMER_TYPE_MAP_ICON] = 0;
+	chunkBytes[STREAMER_TYPE_3D_TEXT_LABEL] = 0;
 	chunkTickCount[STREAMER_TYPE_OBJECT] = 0;
 	chunkTickCount[STREAMER_TYPE_MAP_ICON] = 0;
 	chunkTickCount[STREAMER_TYPE_3D_TEXT_LABEL] = 0;
@@ -44,7 +52,9 @@ Player::Player(int id)
 	delayedRaceCheckpoint = 0;
 	delayedUpdate = false;
 	delayedUpdateType = 0;
+	drivenVehicleID = INVALID_VEHICLE_ID;
 	enabledItems.set();
+	internalAreasVersion = 0;
 	interiorID = 0;
 	maxVisibleMapIcons = core->getData()->getGlobalMaxVisibleItems(STREAMER_TYPE_MAP_ICON);
 	maxVisibleObjects = core->getData()->getGlobalMaxVisibleItems(STREAMER_TYPE_OBJECT);
@@ -60,9 +70,10 @@ Player::Player(int id)
 	radiusMultipliers[STREAMER_TYPE_AREA] = core->getData()->getGlobalRadiusMultiplier(STREAMER_TYPE_AREA);
 	radiusMultipliers[STREAMER_TYPE_ACTOR] = core->getData()->getGlobalRadiusMultiplier(STREAMER_TYPE_ACTOR);
 	radiusMultipliers[STREAMER_TYPE_VEHICLE] = core->getData()->getGlobalRadiusMultiplier(STREAMER_TYPE_VEHICLE);
+	referenceUpdate = 0;
 	requestingClass = false;
-	tickCount = 0;
 	tickRate = 50;
+	tickCount = static_cast<std::size_t>(id) % tickRate;
 	updateUsingCameraPosition = false;
 	updateWhenIdle = false;
 	visibleCell = SharedCell(new Cell());
@@ -22,6 +22,7 @@
 #include "identifier.h"
 
 #include <boost/intrusive_ptr.hpp>
+#include <boost/tuple/tuple.hpp>
 #include <boost/unordered_map.hpp>
 #include <boost/unordered_set.hpp>
 
@@ -29,6 +30,149 @@
 
 #include <bitset>
 #include <map>
+#include <vector>
+
+template<typename T>
+struct CachedCell
+{
+	CachedCell() : candidateUpdate(0), update(0), version(0) {}
+
+	std::size_t candidateUpdate;
+	SharedCell cell;
+	std::size_t update;
+	std::size_t version;
+	std::vector<T> items;
+
+	std::vector<T> packedItems;
+	std::vector<int> packedIDs;
+	std::vector<float> packedX;
+	std::vector<float> packedY;
+	std::vector<float> packedZ;
+	std::vector<float> packedStreamDistances;
+	std::vector<float> packedDistances;
+	std::vector<std::size_t> packedCandidates;
+};
+
+template<typename T>
+struct FilteredCell
+{
+	FilteredCell() : conditionVersion(0), update(0), version(0) {}
+
+	SharedCell cell;
+	std::size_t conditionVersion;
+	std::size_t update;
+	std::size_t version;
+	std::vector<int> excludedIDs;
+	std::vector<T> items;
+};
+
+struct RemovalQueue
+{
+	RemovalQueue() : position(0) {}
+
+	inline bool empty() const
+	{
+		return position == items.size();
+	}
+
+	inline void push(int id)
+	{
+		if (queuedItems.insert(id).second)
+		{
+			items.push_back(id);
+		}
+	}
+
+	inline int pop()
+	{
+		int id = items[position++];
+		queuedItems.erase(id);
+		if (position == items.size())
+		{
+			items.clear();
+			position = 0;
+		}
+		return id;
+	}
+
+	std::size_t position;
+	std::vector<int> items;
+	boost::unordered_set<int> queuedItems;
+};
+
+struct StreamedItems
+{
+	inline bool contains(int id) const
+	{
+		return id >= 0 && static_cast<std::size_t>(id) < items.size() && items[id];
+	}
+
+	inline void insert(int id)
+	{
+		if (id >= 0)
+		{
+			if (static_cast<std::size_t>(id) >= items.size())
+			{
+				items.resize(id + 1, false);
+			}
+			items[id] = true;
+		}
+	}
+
+	inline void erase(int id)
+	{
+		if (contains(id))
+		{
+			items[id] = false;
+		}
+	}
+
+	inline void clear()
+	{
+		items.clear();
+	}
+
+	std::vector<bool> items;
+};
+
+struct ReverseIndex
+{
+	inline int find(int internalID) const
+	{
+		if (internalID >= 0 && static_cast<std::size_t>(internalID) < ids.size())
+		{
+			return ids[internalID];
+		}
+		return INVALID_STREAMER_ID;
+	}
+
+	inline void insert(int internalID, int id)
+	{
+		if (internalID >= 0 && internalID != INVALID_GENERIC_ID)
+		{
+			if (static_cast<std::size_t>(internalID) >= ids.size())
+			{
+				ids.resize(internalID + 1, INVALID_STREAMER_ID);
+			}
+			ids[internalID] = id;
+		}
+	}
+
+	inline void erase(int internalID)
+	{
+		if (internalID >= 0 && static_cast<std::size_t>(internalID) < ids.size())
+		{
+			ids[internalID] = INVALID_STREAMER_ID;
+		}
+	}
+
+	inline void clear()
+	{
+		ids.clear();
+	}
+
+	std::vector<int> ids;
+};
 
 struct Player
 {
@@ -36,9 +180,13 @@ struct Player
 
 	int activeCheckpoint;
 	int activeRaceCheckpoint;
-	bool checkedActors;
-	bool checkedPickups;
-	bool checkedVehicles;
+	boost::tuple<std::size_t, std::size_t, int, int> cachedCellConditions;
+	std::size_t cachedCellUpdate;
+	Eigen::Vector3f candidatePosition;
+	float candidateMargin;
+	std::size_t candidateUpdate;
+	std::size_t chunkByteBudget[STREAMER_MAX_TYPES];
+	std::size_t chunkBytes[STREAMER_MAX_TYPES];
 	std::size_t chunkTickCount[STREAMER_MAX_TYPES];
 	std::size_t chunkTickRate[STREAMER_MAX_TYPES];
 	std::size_t currentVisibleObjects;
@@ -49,6 +197,8 @@ struct Player
 	bool delayedUpdateFreeze;
 	boost::chrono::steady_clock::time_point delayedUpdateTime;
 	int delayedUpdateType;
+	int drivenVehicleID;
+	std::size_t internalAreasVersion;
 	int interiorID;
 	std::size_t maxVisibleMapIcons;
 	std::size_t maxVisibleObjects;
@@ -57,6 +207,7 @@ struct Player
 	Eigen::Vector3f position;
 	float radiusMultipliers[STREAMER_MAX_TYPES];
 	int references;
+	std::size_t referenceUpdate;
 	bool requestingClass;
 	std::size_t tickCount;
 	std::size_t tickRate;
@@ -70,21 +221,36 @@ struct Player
 	std::bitset<STREAMER_MAX_TYPES> enabledItems;
 	std::bitset<STREAMER_MAX_TYPES> processingChunks;
 
-	std::multimap<std::pair<int, float>, Item::SharedMapIcon, Item::Compare> discoveredMapIcons;
-	std::multimap<std::pair<int, float>, Item::SharedMapIcon, Item::Compare> existingMapIcons;
-	std::multimap<std::pair<int, float>, Item::SharedObject, Item::Compare> discoveredObjects;
-	std::multimap<std::pair<int, float>, Item::SharedObject, Item::Compare> existingObjects;
-	std::multimap<std::pair<int, float>, Item::SharedTextLabel, Item::Compare> discoveredTextLabels;
-	std::multimap<std::pair<int, float>, Item::SharedTextLabel, Item::Compare> existingTextLabels;
+	std::vector<std::pair<std::pair<int, float>, Item::SharedMapIcon> > discoveredMapIcons;
+	std::vector<std::pair<std::pair<int, float>, Item::SharedMapIcon> > existingMapIcons;
+	std::vector<std::pair<std::pair<int, float>, Item::SharedObject> > discoveredObjects;
+	std::vector<std::pair<std::pair<int, float>, Item::SharedObject> > existingObjects;
+	std::vector<std::pair<std::pair<int, float>, Item::SharedTextLabel> > discoveredTextLabels;
+	std::vector<std::pair<std::pair<int, float>, Item::SharedTextLabel> > existingTextLabels;
+
+	boost::unordered_map<Cell*, CachedCell<Item::SharedMapIcon> > cachedMapIconCells;
+	boost::unordered_map<Cell*, CachedCell<Item::SharedObject> > cachedObjectCells;
+	boost::unordered_map<Cell*, CachedCell<Item::SharedTextLabel> > cachedTextLabelCells;
+
+	boost::unordered_map<int, std::size_t> referencedActors;
+	boost::unordered_map<int, std::size_t> referencedPickups;
+	boost::unordered_map<int, std::size_t> referencedVehicles;
 
 	boost::unordered_set<int> internalAreas;
 	boost::unordered_map<int, int> internalMapIcons;
 	boost::unordered_map<int, int> internalObjects;
 	boost::unordered_map<int, int> internalTextLabels;
 
-	std::vector<int> removedMapIcons;
-	std::vector<int> removedObjects;
-	std::vector<int> removedTextLabels;
+	StreamedItems streamedMapIcons;
+	StreamedItems streamedObjects;
+	StreamedItems streamedTextLabels;
+
+	ReverseIndex reverseObjects;
+	ReverseIndex reverseTextLabels;
+
+	RemovalQueue removedMapIcons;
+	RemovalQueue removedObjects;
+	RemovalQueue removedTextLabels;
 
 	Identifier mapIconIdentifier;
 
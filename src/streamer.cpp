@@ -25,6 +25,7 @@
 #include <boost/intrusive_ptr.hpp>
 #include <boost/scoped_ptr.hpp>
 #include <boost/tuple/tuple.hpp>
+#include <boost/tuple/tuple_comparison.hpp>
 #include <boost/unordered_map.hpp>
 #include <boost/unordered_set.hpp>
 #include <boost/variant.hpp>
@@ -32,6 +33,7 @@
 #include <Eigen/Core>
 
 #include <bitset>
+#include <functional>
 #include <limits>
 #include <map>
 #include <set>
@@ -44,7 +46,10 @@ Streamer::Streamer()
 	chunkSize[STREAMER_TYPE_OBJECT] = 100;
 	chunkSize[STREAMER_TYPE_MAP_ICON] = 100;
 	chunkSize[STREAMER_TYPE_3D_TEXT_LABEL] = 100;
+	filteredCellUpdate = 0;
 	lastUpdateTime = 0.0f;
+	pendingPlayerUpdates = 0;
+	tickBudget = 0;
 	tickCount = 0;
 	tickRate = 50;
 	velocityBoundaries = boost::make_tuple(0.25f, 7.5f);
@@ -121,10 +126,15 @@ void Streamer::startAutomaticUpdate()
 {
 	if (!core->getData()->interfaces.empty())
 	{
+		if (core->getGrid()->isRebuildingGrid())
+		{
+			core->getGrid()->processGridRebuild(STREAMER_GRID_REBUILD_CHUNK_SIZE);
+		}
 		boost::chrono::steady_clock::time_point currentTime = boost::chrono::steady_clock::now();
 		if (!core->getData()->players.empty())
 		{
 			bool updatedActiveItems = false;
+			std::multimap<std::size_t, Player*, std::greater<std::size_t> > duePlayers;
 			for (boost::unordered_map<int, Player>::iterator p = core->getData()->players.begin(); p != core->getData()->players.end(); ++p)
 			{
 				if (p->second.processingChunks.any())
@@ -135,62 +145,76 @@ void Streamer::startAutomaticUpdate()
 				{
 					if (++p->second.tickCount >= p->second.tickRate)
 					{
-						if (!updatedActiveItems)
-						{
-							processActiveItems();
-							updatedActiveItems = true;
-						}
-						if (!p->second.delayedUpdate)
-						{
-							performPlayerUpdate(p->second, true);
-						}
-						else
-						{
-							startManualUpdate(p->second, p->second.delayedUpdateType);
-						}
-						p->second.tickCount = 0;
+						duePlayers.insert(std::make_pair(p->second.tickCount - p->second.tickRate, &p->second));
 					}
 				}
 			}
+			pendingPlayerUpdates = duePlayers.size();
+			for (std::multimap<std::size_t, Player*, std::greater<std::size_t> >::iterator p = duePlayers.begin(); p != duePlayers.end(); ++p)
+			{
+				if (tickBudget && updatedActiveItems && boost::chrono::duration_cast<boost::chrono::microseconds>(boost::chrono::steady_clock::now() - currentTime).count() >= static_cast<boost::int_least64_t>(tickBudget))
+				{
+					break;
+				}
+				if (!updatedActiveItems)
+				{
+					processActiveItems();
+					updatedActiveItems = true;
+				}
+				if (!p->second->delayedUpdate)
+				{
+					performPlayerUpdate(*p->second, true);
+				}
+				else
+				{
+					startManualUpdate(*p->second, p->second->delayedUpdateType);
+				}
+				p->second->tickCount = 0;
+				--pendingPlayerUpdates;
+			}
 		}
 		else
 		{
 			processActiveItems();
 		}
-		if (++tickCount >= tickRate)
+		for (std::vector<int>::const_iterator t = core->getData()->typePriority.begin(); t != core->getData()->typePriority.end(); ++t)
 		{
-			for (std::vector<int>::const_iterator t = core->getData()->typePriority.begin(); t != core->getData()->typePriority.end(); ++t)
+			switch (*t)
 			{
-				switch (*t)
+				case STREAMER_TYPE_PICKUP:
 				{
-					case STREAMER_TYPE_PICKUP:
+					if (!core->getData()->releasedPickups.empty() || !core->getData()->discoveredPickups.empty())
 					{
-						if (Utility::haveAllPlayersCheckedPickups())
-						{
-							streamPickups();
-						}
-						break;
+						streamPickups();
 					}
-					case STREAMER_TYPE_ACTOR:
+					break;
+				}
+				case STREAMER_TYPE_ACTOR:
+				{
+					Utility::processPendingDestroyedActors();
+					if (!core->getData()->releasedActors.empty() || !core->getData()->discoveredActors.empty())
 					{
-						Utility::processPendingDestroyedActors();
-						if (Utility::haveAllPlayersCheckedActors())
-						{
-							streamActors();
-						}
-						break;
+						streamActors();
 					}
-					case STREAMER_TYPE_VEHICLE:
+					break;
+				}
+				case STREAMER_TYPE_VEHICLE:
+				{
+					if (!core->getData()->releasedVehicles.empty() || !core->getData()->discoveredVehicles.empty())
 					{
-						if (Utility::haveAllPlayersCheckedVehicles())
-						{
-							streamVehicles();
-						}
-						break;
+						streamVehicles();
 					}
+					break;
 				}
 			}
+		}
+		if (++tickCount >= tickRate)
+		{
 			executeCallbacks();
+			eraseStaleFilteredCells(filteredMapIconCells);
+			eraseStaleFilteredCells(filteredObjectCells);
+			eraseStaleFilteredCells(filteredTextLabelCells);
+			++filteredCellUpdate;
 			tickCount = 0;
 		}
 		calculateAverageElapsedTime();
@@ -198,6 +222,13 @@ void Streamer::startAutomaticUpdate()
 	}
 }
 
+void Streamer::releasePlayerReferences(Player &player)
+{
+	releaseActorReferences(player);
+	releasePickupReferences(player);
+	releaseVehicleReferences(player);
+}
+
 void Streamer::startManualUpdate(Player &player, int type)
 {
 	std::bitset<STREAMER_MAX_TYPES> enabledItems = player.enabledItems;
@@ -292,86 +323,103 @@ void Streamer::performPlayerChunkUpdate(Player &player, bool automatic)
 
 void Streamer::performPlayerUpdate(Player &player, bool automatic)
 {
-	Eigen::Vector3f delta = Eigen::Vector3f::Zero(), position = player.position;
+	Eigen::Vector3f delta = Eigen::Vector3f::Zero();
 	bool update = true;
 	if (automatic)
 	{
-		player.interiorID = sampgdk::GetPlayerInterior(player.playerID);
-		player.worldID = sampgdk::GetPlayerVirtualWorld(player.playerID);
-		if (!player.updateUsingCameraPosition)
+		update = updatePlayerState(player, delta);
+	}
+	if (!objectMoves.empty())
+	{
+		objectMoveTime = boost::chrono::steady_clock::now();
+	}
+	discoverPlayerItems(player, update, automatic, delta);
+}
+
+bool Streamer::updatePlayerState(Player &player, Eigen::Vector3f &delta)
+{
+	Eigen::Vector3f position = player.position;
+	bool update = true;
+	player.interiorID = sampgdk::GetPlayerInterior(player.playerID);
+	player.worldID = sampgdk::GetPlayerVirtualWorld(player.playerID);
+	if (!player.updateUsingCameraPosition)
+	{
+		int state = sampgdk::GetPlayerState(player.playerID);
+		if ((state != PLAYER_STATE_NONE && state != PLAYER_STATE_WASTED) || (state == PLAYER_STATE_SPECTATING && !player.requestingClass))
 		{
-			int state = sampgdk::GetPlayerState(player.playerID);
-			if ((state != PLAYER_STATE_NONE && state != PLAYER_STATE_WASTED) || (state == PLAYER_STATE_SPECTATING && !player.requestingClass))
+			if (!sampgdk::IsPlayerInAnyVehicle(player.playerID))
 			{
-				if (!sampgdk::IsPlayerInAnyVehicle(player.playerID))
-				{
-					sampgdk::GetPlayerPos(player.playerID, &player.position[0], &player.position[1], &player.position[2]);
-				}
-				else
+				sampgdk::GetPlayerPos(player.playerID, &player.position[0], &player.position[1], &player.position[2]);
+			}
+			else
+			{
+				sampgdk::GetVehiclePos(sampgdk::GetPlayerVehicleID(player.playerID), &player.position[0], &player.position[1], &player.position[2]);
+			}
+			if (player.position != position)
+			{
+				Eigen::Vector3f velocity = Eigen::Vector3f::Zero();
+				if (state == PLAYER_STATE_ONFOOT)
 				{
-					sampgdk::GetVehiclePos(sampgdk::GetPlayerVehicleID(player.playerID), &player.position[0], &player.position[1], &player.position[2]);
+					sampgdk::GetPlayerVelocity(player.playerID, &velocity[0], &velocity[1], &velocity[2]);
 				}
-				if (player.position != position)
+				else if (state == PLAYER_STATE_DRIVER || state == PLAYER_STATE_PASSENGER)
 				{
-					position = player.position;
-					Eigen::Vector3f velocity = Eigen::Vector3f::Zero();
-					if (state == PLAYER_STATE_ONFOOT)
-					{
-						sampgdk::GetPlayerVelocity(player.playerID, &velocity[0], &velocity[1], &velocity[2]);
-					}
-					else if (state == PLAYER_STATE_DRIVER || state == PLAYER_STATE_PASSENGER)
-					{
-						sampgdk::GetVehicleVelocity(sampgdk::GetPlayerVehicleID(player.playerID), &velocity[0], &velocity[1], &velocity[2]);
-					}
-					float velocityNorm = velocity.squaredNorm();
-					if (velocityNorm > velocityBoundaries.get<0>() && velocityNorm < velocityBoundaries.get<1>())
-					{
-						delta = velocity * averageElapsedTime;
-					}
+					sampgdk::GetVehicleVelocity(sampgdk::GetPlayerVehicleID(player.playerID), &velocity[0], &velocity[1], &velocity[2]);
 				}
-				else
+				float velocityNorm = velocity.squaredNorm();
+				if (velocityNorm > velocityBoundaries.get<0>() && velocityNorm < velocityBoundaries.get<1>())
 				{
-					update = player.updateWhenIdle;
+					delta = velocity * averageElapsedTime;
 				}
 			}
 			else
 			{
-				update = false;
+				update = player.updateWhenIdle;
 			}
 		}
 		else
 		{
-			sampgdk::GetPlayerCameraPos(player.playerID, &player.position[0], &player.position[1], &player.position[2]);
+			update = false;
 		}
-		if (player.delayedCheckpoint)
+	}
+	else
+	{
+		sampgdk::GetPlayerCameraPos(player.playerID, &player.position[0], &player.position[1], &player.position[2]);
+	}
+	if (player.delayedCheckpoint)
+	{
+		boost::unordered_map<int, Item::SharedCheckpoint>::iterator c = core->getData()->checkpoints.find(player.delayedCheckpoint);
+		if (c != core->getData()->checkpoints.end())
 		{
-			boost::unordered_map<int, Item::SharedCheckpoint>::iterator c = core->getData()->checkpoints.find(player.delayedCheckpoint);
-			if (c != core->getData()->checkpoints.end())
+			sampgdk::SetPlayerCheckpoint(player.playerID, c->second->position[0], c->second->position[1], c->second->position[2], c->second->size);
+			if (c->second->streamCallbacks)
 			{
-				sampgdk::SetPlayerCheckpoint(player.playerID, c->second->position[0], c->second->position[1], c->second->position[2], c->second->size);
-				if (c->second->streamCallbacks)
-				{
-					streamInCallbacks.push_back(boost::make_tuple(STREAMER_TYPE_CP, c->first));
-				}
-				player.visibleCheckpoint = c->first;
+				streamInCallbacks.push_back(boost::make_tuple(STREAMER_TYPE_CP, c->first));
 			}
-			player.delayedCheckpoint = 0;
+			player.visibleCheckpoint = c->first;
 		}
-		else if (player.delayedRaceCheckpoint)
+		player.delayedCheckpoint = 0;
+	}
+	else if (player.delayedRaceCheckpoint)
+	{
+		boost::unordered_map<int, Item::SharedRaceCheckpoint>::iterator r = core->getData()->raceCheckpoints.find(player.delayedRaceCheckpoint);
+		if (r != core->getData()->raceCheckpoints.end())
 		{
-			boost::unordered_map<int, Item::SharedRaceCheckpoint>::iterator r = core->getData()->raceCheckpoints.find(player.delayedRaceCheckpoint);
-			if (r != core->getData()->raceCheckpoints.end())
+			sampgdk::SetPlayerRaceCheckpoint(player.playerID, r->second->type, r->second->position[0], r->second->position[1], r->second->position[2], r->second->next[0], r->second->next[1], r->second->next[2], r->second->size);
+			if (r->second->streamCallbacks)
 			{
-				sampgdk::SetPlayerRaceCheckpoint(player.playerID, r->second->type, r->second->position[0], r->second->position[1], r->second->position[2], r->second->next[0], r->second->next[1], r->second->next[2], r->second->size);
-				if (r->second->streamCallbacks)
-				{
-					streamInCallbacks.push_back(boost::make_tuple(STREAMER_TYPE_RACE_CP, r->first));
-				}
-				player.visibleRaceCheckpoint = r->first;
+				streamInCallbacks.push_back(boost::make_tuple(STREAMER_TYPE_RACE_CP, r->first));
 			}
-			player.delayedRaceCheckpoint = 0;
+			player.visibleRaceCheckpoint = r->first;
 		}
+		player.delayedRaceCheckpoint = 0;
 	}
+	return update;
+}
+
+void Streamer::discoverPlayerItems(Player &player, bool update, bool automatic, const Eigen::Vector3f &delta)
+{
+	Eigen::Vector3f position = player.position;
 	std::vector<SharedCell> cells;
 	if (update)
 	{
@@ -387,6 +435,14 @@ void Streamer::performPlayerUpdate(Player &player, bool automatic)
 		{
 			player.position += delta;
 		}
+		if (automatic)
+		{
+			++player.referenceUpdate;
+		}
+		if (update)
+		{
+			validateCachedCells(player);
+		}
 		for (std::vector<int>::const_iterator t = core->getData()->typePriority.begin(); t != core->getData()->typePriority.end(); ++t)
 		{
 			if (update)
@@ -441,7 +497,7 @@ void Streamer::performPlayerUpdate(Player &player, bool automatic)
 							{
 								player.position = position;
 							}
-							processAreas(player, cells);
+							processAreas(player);
 							if (!delta.isZero())
 							{
 								player.position += delta;
@@ -461,6 +517,10 @@ void Streamer::performPlayerUpdate(Player &player, bool automatic)
 						{
 							discoverPickups(player, cells);
 						}
+						else if (!player.referencedPickups.empty())
+						{
+							releasePickupReferences(player);
+						}
 						break;
 					}
 					case STREAMER_TYPE_ACTOR:
@@ -469,6 +529,10 @@ void Streamer::performPlayerUpdate(Player &player, bool automatic)
 						{
 							discoverActors(player, cells);
 						}
+						else if (!player.referencedActors.empty())
+						{
+							releaseActorReferences(player);
+						}
 						break;
 					}
 					case STREAMER_TYPE_VEHICLE:
@@ -477,6 +541,10 @@ void Streamer::performPlayerUpdate(Player &player, bool automatic)
 						{
 							discoverVehicles(player, cells);
 						}
+						else if (!player.referencedVehicles.empty())
+						{
+							releaseVehicleReferences(player);
+						}
 						break;
 					}
 				}
@@ -494,16 +562,18 @@ void Streamer::executeCallbacks()
 	if (!areaLeaveCallbacks.empty())
 	{
 		std::multimap<int, boost::tuple<int, int> > callbacks;
+		std::map<int, std::vector<int> > batches;
 		std::swap(areaLeaveCallbacks, callbacks);
 		for (std::multimap<int, boost::tuple<int, int> >::reverse_iterator c = callbacks.rbegin(); c != callbacks.rend(); ++c)
 		{
 			boost::unordered_map<int, Item::SharedArea>::iterator a = core->getData()->areas.find(c->second.get<0>());
 			if (a != core->getData()->areas.end())
 			{
+				batches[c->second.get<1>()].push_back(c->second.get<0>());
 				for (std::set<AMX*>::iterator i = core->getData()->interfaces.begin(); i != core->getData()->interfaces.end(); ++i)
 				{
 					int amxIndex = 0;
-					if (!amx_FindPublic(*i, "OnPlayerLeaveDynamicArea", &amxIndex))
+					if (!Utility::findPublic(*i, STREAMER_CALLBACK_ON_PLAYER_LEAVE_DYNAMIC_AREAS, amxIndex) && Utility::findPublic(*i, STREAMER_CALLBACK_ON_PLAYER_LEAVE_DYNAMIC_AREA, amxIndex))
 					{
 						amx_Push(*i, static_cast<cell>(c->second.get<0>()));
 						amx_Push(*i, static_cast<cell>(c->second.get<1>()));
@@ -512,20 +582,23 @@ void Streamer::executeCallbacks()
 				}
 			}
 		}
+		Utility::executeBatchedCallbacks(STREAMER_CALLBACK_ON_PLAYER_LEAVE_DYNAMIC_AREAS, batches);
 	}
 	if (!areaEnterCallbacks.empty())
 	{
 		std::multimap<int, boost::tuple<int, int> > callbacks;
+		std::map<int, std::vector<int> > batches;
 		std::swap(areaEnterCallbacks, callbacks);
 		for (std::multimap<int, boost::tuple<int, int> >::reverse_iterator c = callbacks.rbegin(); c != callbacks.rend(); ++c)
 		{
 			boost::unordered_map<int, Item::SharedArea>::iterator a = core->getData()->areas.find(c->second.get<0>());
 			if (a != core->getData()->areas.end())
 			{
+				batches[c->second.get<1>()].push_back(c->second.get<0>());
 				for (std::set<AMX*>::iterator i = core->getData()->interfaces.begin(); i != core->getData()->interfaces.end(); ++i)
 				{
 					int amxIndex = 0;
-					if (!amx_FindPublic(*i, "OnPlayerEnterDynamicArea", &amxIndex))
+					if (!Utility::findPublic(*i, STREAMER_CALLBACK_ON_PLAYER_ENTER_DYNAMIC_AREAS, amxIndex) && Utility::findPublic(*i, STREAMER_CALLBACK_ON_PLAYER_ENTER_DYNAMIC_AREA, amxIndex))
 					{
 						amx_Push(*i, static_cast<cell>(c->second.get<0>()));
 						amx_Push(*i, static_cast<cell>(c->second.get<1>()));
@@ -534,6 +607,7 @@ void Streamer::executeCallbacks()
 				}
 			}
 		}
+		Utility::executeBatchedCallbacks(STREAMER_CALLBACK_ON_PLAYER_ENTER_DYNAMIC_AREAS, batches);
 	}
 	if (!objectMoveCallbacks.empty())
 	{
@@ -547,7 +621,7 @@ void Streamer::executeCallbacks()
 				for (std::set<AMX*>::iterator i = core->getData()->interfaces.begin(); i != core->getData()->interfaces.end(); ++i)
 				{
 					int amxIndex = 0;
-					if (!amx_FindPublic(*i, "OnDynamicObjectMoved", &amxIndex))
+					if (Utility::findPublic(*i, STREAMER_CALLBACK_ON_DYNAMIC_OBJECT_MOVED, amxIndex))
 					{
 						amx_Push(*i, static_cast<cell>(*c));
 						amx_Exec(*i, NULL, amxIndex);
@@ -559,6 +633,7 @@ void Streamer::executeCallbacks()
 	if (!streamInCallbacks.empty())
 	{
 		std::vector<boost::tuple<int, int> > callbacks;
+		std::map<int, std::vector<int> > batches;
 		std::swap(streamInCallbacks, callbacks);
 		for (std::vector<boost::tuple<int, int> >::const_iterator c = callbacks.begin(); c != callbacks.end(); ++c)
 		{
@@ -621,10 +696,11 @@ void Streamer::executeCallbacks()
 					break;
 				}
 			}
+			batches[c->get<0>()].push_back(c->get<1>());
 			for (std::set<AMX*>::iterator i = core->getData()->interfaces.begin(); i != core->getData()->interfaces.end(); ++i)
 			{
 				int amxIndex = 0;
-				if (!amx_FindPublic(*i, "Streamer_OnItemStreamIn", &amxIndex))
+				if (!Utility::findPublic(*i, STREAMER_CALLBACK_ON_ITEMS_STREAM_IN, amxIndex) && Utility::findPublic(*i, STREAMER_CALLBACK_ON_ITEM_STREAM_IN, amxIndex))
 				{
 					amx_Push(*i, static_cast<cell>(c->get<1>()));
 					amx_Push(*i, static_cast<cell>(c->get<0>()));
@@ -632,10 +708,12 @@ void Streamer::executeCallbacks()
 				}
 			}
 		}
+		Utility::executeBatchedCallbacks(STREAMER_CALLBACK_ON_ITEMS_STREAM_IN, batches);
 	}
 	if (!streamOutCallbacks.empty())
 	{
 		std::vector<boost::tuple<int, int> > callbacks;
+		std::map<int, std::vector<int> > batches;
 		std::swap(streamOutCallbacks, callbacks);
 		for (std::vector<boost::tuple<int, int> >::const_iterator c = callbacks.begin(); c != callbacks.end(); ++c)
 		{
@@ -698,10 +776,11 @@ void Streamer::executeCallbacks()
 					break;
 				}
 			}
+			batches[c->get<0>()].push_back(c->get<1>());
 			for (std::set<AMX*>::iterator i = core->getData()->interfaces.begin(); i != core->getData()->interfaces.end(); ++i)
 			{
 				int amxIndex = 0;
-				if (!amx_FindPublic(*i, "Streamer_OnItemStreamOut", &amxIndex))
+				if (!Utility::findPublic(*i, STREAMER_CALLBACK_ON_ITEMS_STREAM_OUT, amxIndex) && Utility::findPublic(*i, STREAMER_CALLBACK_ON_ITEM_STREAM_OUT, amxIndex))
 				{
 					amx_Push(*i, static_cast<cell>(c->get<1>()));
 					amx_Push(*i, static_cast<cell>(c->get<0>()));
@@ -709,7 +788,26 @@ void Streamer::executeCallbacks()
 				}
 			}
 		}
+		Utility::executeBatchedCallbacks(STREAMER_CALLBACK_ON_ITEMS_STREAM_OUT, batches);
+	}
+}
+
+void Streamer::validateCachedCells(Player &player)
+{
+	boost::tuple<std::size_t, std::size_t, int, int> conditions = boost::make_tuple(core->getData()->conditionVersion, player.internalAreasVersion, player.interiorID, player.worldID);
+	if (conditions != player.cachedCellConditions)
+	{
+		player.cachedMapIconCells.clear();
+		player.cachedObjectCells.clear();
+		player.cachedTextLabelCells.clear();
+		player.cachedCellConditions = conditions;
 	}
+	if (player.candidateMargin > 0.0f && (player.position - player.candidatePosition).squaredNorm() > (player.candidateMargin * player.candidateMargin * 0.25f))
+	{
+		player.candidatePosition = player.position;
+		++player.candidateUpdate;
+	}
+	++player.cachedCellUpdate;
 }
 
 void Streamer::discoverActors(Player &player, const std::vector<SharedCell> &cells)
@@ -718,50 +816,98 @@ void Streamer::discoverActors(Player &player, const std::vector<SharedCell> &cel
 	{
 		for (boost::unordered_map<int, Item::SharedActor>::const_iterator a = (*c)->actors.begin(); a != (*c)->actors.end(); ++a)
 		{
-			boost::unordered_map<int, Item::SharedActor>::iterator d = core->getData()->discoveredActors.find(a->first);
-			if (d == core->getData()->discoveredActors.end())
+			if (doesPlayerSatisfyConditions(a->second->players, player.playerID, a->second->interiors, player.interiorID, a->second->worlds, player.worldID, a->second->areas, player.internalAreas, a->second->inverseAreaChecking))
 			{
-				if (doesPlayerSatisfyConditions(a->second->players, player.playerID, a->second->interiors, player.interiorID, a->second->worlds, player.worldID, a->second->areas, player.internalAreas, a->second->inverseAreaChecking))
+				if (a->second->comparableStreamDistance < STREAMER_STATIC_DISTANCE_CUTOFF || boost::geometry::comparable_distance(player.position, Eigen::Vector3f(a->second->position + a->second->positionOffset)) < (a->second->comparableStreamDistance * player.radiusMultipliers[STREAMER_TYPE_ACTOR]))
 				{
-					if (a->second->comparableStreamDistance < STREAMER_STATIC_DISTANCE_CUTOFF || boost::geometry::comparable_distance(player.position, Eigen::Vector3f(a->second->position + a->second->positionOffset)) < (a->second->comparableStreamDistance * player.radiusMultipliers[STREAMER_TYPE_ACTOR]))
+					std::pair<boost::unordered_map<int, std::size_t>::iterator, bool> r = player.referencedActors.insert(std::make_pair(a->first, player.referenceUpdate));
+					if (r.second)
 					{
-						boost::unordered_map<int, int>::iterator i = core->getData()->internalActors.find(a->first);
-						if (i == core->getData()->internalActors.end())
-						{
-							a->second->worldID = !a->second->worlds.empty() ? player.worldID : 0;
-						}
-						core->getData()->discoveredActors.insert(*a);
+						addActorReference(player, a->second);
+					}
+					else
+					{
+						r.first->second = player.referenceUpdate;
 					}
 				}
 			}
 		}
 	}
-	player.checkedActors = true;
+	boost::unordered_map<int, std::size_t>::iterator r = player.referencedActors.begin();
+	while (r != player.referencedActors.end())
+	{
+		if (r->second != player.referenceUpdate)
+		{
+			removeActorReference(r->first);
+			r = player.referencedActors.erase(r);
+		}
+		else
+		{
+			++r;
+		}
+	}
 }
 
-void Streamer::streamActors()
+void Streamer::addActorReference(Player &player, const Item::SharedActor &actor)
 {
-	boost::unordered_map<int, int>::iterator i = core->getData()->internalActors.begin();
-	while (i != core->getData()->internalActors.end())
+	if (++core->getData()->actorReferences[actor->actorID] == 1)
 	{
-		boost::unordered_map<int, Item::SharedActor>::iterator d = core->getData()->discoveredActors.find(i->first);
-		if (d == core->getData()->discoveredActors.end())
+		if (core->getData()->internalActors.find(actor->actorID) == core->getData()->internalActors.end())
 		{
-			sampgdk::DestroyActor(i->second);
-			i = core->getData()->internalActors.erase(i);
+			actor->worldID = !actor->worlds.empty() ? player.worldID : 0;
+			core->getData()->discoveredActors.insert(std::make_pair(actor->actorID, actor));
 		}
-		else
+	}
+}
+
+void Streamer::removeActorReference(int actorID)
+{
+	boost::unordered_map<int, std::size_t>::iterator r = core->getData()->actorReferences.find(actorID);
+	if (r != core->getData()->actorReferences.end())
+	{
+		if (!--r->second)
+		{
+			core->getData()->actorReferences.quick_erase(r);
+			core->getData()->discoveredActors.erase(actorID);
+			core->getData()->releasedActors.push_back(actorID);
+		}
+	}
+}
+
+void Streamer::releaseActorReferences(Player &player)
+{
+	for (boost::unordered_map<int, std::size_t>::const_iterator r = player.referencedActors.begin(); r != player.referencedActors.end(); ++r)
+	{
+		removeActorReference(r->first);
+	}
+	player.referencedActors.clear();
+}
+
+void Streamer::streamActors()
+{
+	for (std::vector<int>::const_iterator r = core->getData()->releasedActors.begin(); r != core->getData()->releasedActors.end(); ++r)
+	{
+		if (core->getData()->actorReferences.find(*r) == core->getData()->actorReferences.end())
 		{
-			core->getData()->discoveredActors.erase(d);
-			++i;
+			boost::unordered_map<int, int>::iterator i = core->getData()->internalActors.find(*r);
+			if (i != core->getData()->internalActors.end())
+			{
+				sampgdk::DestroyActor(i->second);
+				core->getData()->reverseActors.erase(i->second);
+				core->getData()->internalActors.quick_erase(i);
+			}
 		}
 	}
+	core->getData()->releasedActors.clear();
+	if (core->getData()->discoveredActors.empty() || core->getData()->internalActors.size() >= core->getData()->getGlobalMaxVisibleItems(STREAMER_TYPE_ACTOR))
+	{
+		return;
+	}
 	std::multimap<int, Item::SharedActor> sortedActors;
 	for (boost::unordered_map<int, Item::SharedActor>::iterator d = core->getData()->discoveredActors.begin(); d != core->getData()->discoveredActors.end(); ++d)
 	{
 		sortedActors.insert(std::make_pair(d->second->priority, d->second));
 	}
-	core->getData()->discoveredActors.clear();
 	for (std::multimap<int, Item::SharedActor>::iterator i = sortedActors.begin(); i != sortedActors.end(); ++i)
 	{
 		if (core->getData()->internalActors.size() == core->getData()->getGlobalMaxVisibleItems(STREAMER_TYPE_ACTOR))
@@ -781,45 +927,53 @@ void Streamer::streamActors()
 			sampgdk::ApplyActorAnimation(internalID, i->second->anim->lib.c_str(), i->second->anim->name.c_str(), i->second->anim->delta, i->second->anim->loop, i->second->anim->lockx, i->second->anim->locky, i->second->anim->freeze, i->second->anim->time);
 		}
 		core->getData()->internalActors.insert(std::make_pair(i->second->actorID, internalID));
-	}
-	for (boost::unordered_map<int, Player>::iterator p = core->getData()->players.begin(); p != core->getData()->players.end(); ++p)
-	{
-		p->second.checkedActors = false;
+		core->getData()->reverseActors.insert(internalID, i->second->actorID);
+		core->getData()->discoveredActors.erase(i->second->actorID);
 	}
 }
 
-void Streamer::processAreas(Player &player, const std::vector<SharedCell> &cells)
+void Streamer::processAreas(Player &player)
 {
-	for (std::vector<SharedCell>::const_iterator c = cells.begin(); c != cells.end(); ++c)
+	int state = sampgdk::GetPlayerState(player.playerID);
+	std::vector<Item::SharedArea> areas;
+	core->getGrid()->findAreasForPoint(Eigen::Vector2f(player.position[0], player.position[1]), areas);
+	for (boost::unordered_set<int>::const_iterator i = player.internalAreas.begin(); i != player.internalAreas.end(); ++i)
 	{
-		int state = sampgdk::GetPlayerState(player.playerID);
-		for (boost::unordered_map<int, Item::SharedArea>::const_iterator a = (*c)->areas.begin(); a != (*c)->areas.end(); ++a)
+		boost::unordered_map<int, Item::SharedArea>::iterator a = core->getData()->areas.find(*i);
+		if (a != core->getData()->areas.end())
 		{
-			bool inArea = false;
-			if (doesPlayerSatisfyConditions(a->second->players, player.playerID, a->second->interiors, player.interiorID, a->second->worlds, player.worldID) && ((!a->second->spectateMode && state != PLAYER_STATE_SPECTATING) || a->second->spectateMode))
-			{
-				inArea = Utility::isPointInArea(player.position, a->second);
-			}
-			boost::unordered_set<int>::iterator i = player.internalAreas.find(a->first);
-			if (inArea)
+			areas.push_back(a->second);
+		}
+	}
+	boost::unordered_set<int> processedAreas;
+	for (std::vector<Item::SharedArea>::const_iterator a = areas.begin(); a != areas.end(); ++a)
+	{
+		if (!processedAreas.insert((*a)->areaID).second)
+		{
+			continue;
+		}
+		bool inArea = false;
+		if (doesPlayerSatisfyConditions((*a)->players, player.playerID, (*a)->interiors, player.interiorID, (*a)->worlds, player.worldID) && ((!(*a)->spectateMode && state != PLAYER_STATE_SPECTATING) || (*a)->spectateMode))
+		{
+			inArea = Utility::isPointInArea(player.position, *a);
+		}
+		boost::unordered_set<int>::iterator i = player.internalAreas.find((*a)->areaID);
+		if (inArea)
+		{
+			if (i == player.internalAreas.end())
 			{
-				if (i == player.internalAreas.end())
-				{
-					player.internalAreas.insert(a->first);
-					areaEnterCallbacks.insert(std::make_pair(a->second->priority, boost::make_tuple(a->first, player.playerID)));
-				}
-				if (a->second->cell)
-				{
-					player.visibleCell->areas.insert(*a);
-				}
+				player.internalAreas.insert((*a)->areaID);
+				++player.internalAreasVersion;
+				areaEnterCallbacks.insert(std::make_pair((*a)->priority, boost::make_tuple((*a)->areaID, player.playerID)));
 			}
-			else
+		}
+		else
+		{
+			if (i != player.internalAreas.end())
 			{
-				if (i != player.internalAreas.end())
-				{
-					player.internalAreas.quick_erase(i);
-					areaLeaveCallbacks.insert(std::make_pair(a->second->priority, boost::make_tuple(a->first, player.playerID)));
-				}
+				player.internalAreas.quick_erase(i);
+				++player.internalAreasVersion;
+				areaLeaveCallbacks.insert(std::make_pair((*a)->priority, boost::make_tuple((*a)->areaID, player.playerID)));
 			}
 		}
 	}
@@ -889,123 +1043,196 @@ void Streamer::processCheckpoints(Player &player, const std::vector<SharedCell>
 
 void Streamer::discoverMapIcons(Player &player, const std::vector<SharedCell> &cells)
 {
+	FilteredCell<Item::SharedMapIcon> uncachedCell;
 	for (std::vector<SharedCell>::const_iterator c = cells.begin(); c != cells.end(); ++c)
 	{
-		for (boost::unordered_map<int, Item::SharedMapIcon>::const_iterator m = (*c)->mapIcons.begin(); m != (*c)->mapIcons.end(); ++m)
+		CachedCell<Item::SharedMapIcon> *cachedCell = findCachedCell(player, player.cachedMapIconCells, *c);
+		if (cachedCell && cachedCell->version == (*c)->version)
 		{
-			float distance = std::numeric_limits<float>::infinity();
-			if (doesPlayerSatisfyConditions(m->second->players, player.playerID, m->second->interiors, player.interiorID, m->second->worlds, player.worldID, m->second->areas, player.internalAreas, m->second->inverseAreaChecking))
+			calculatePackedDistances(player, *cachedCell, player.radiusMultipliers[STREAMER_TYPE_MAP_ICON], player.streamedMapIcons, player.removedMapIcons);
+			for (std::vector<std::size_t>::const_iterator i = cachedCell->packedCandidates.begin(); i != cachedCell->packedCandidates.end(); ++i)
 			{
-				if (m->second->comparableStreamDistance < STREAMER_STATIC_DISTANCE_CUTOFF)
+				if (cachedCell->packedDistances[*i] < (cachedCell->packedStreamDistances[*i] * player.radiusMultipliers[STREAMER_TYPE_MAP_ICON]))
 				{
-					distance = std::numeric_limits<float>::infinity() * -1.0f;
+					discoverMapIconAtDistance(player, cachedCell->packedItems[*i], cachedCell->packedDistances[*i]);
 				}
 				else
 				{
-					distance = static_cast<float>(boost::geometry::comparable_distance(player.position, Eigen::Vector3f(m->second->position + m->second->positionOffset)));
+					if (player.streamedMapIcons.contains(cachedCell->packedIDs[*i]))
+					{
+						player.removedMapIcons.push(cachedCell->packedIDs[*i]);
+					}
 				}
 			}
-			boost::unordered_map<int, int>::iterator i = player.internalMapIcons.find(m->first);
-			if (distance < (m->second->comparableStreamDistance * player.radiusMultipliers[STREAMER_TYPE_MAP_ICON]))
+			for (std::vector<Item::SharedMapIcon>::const_iterator m = cachedCell->items.begin(); m != cachedCell->items.end(); ++m)
 			{
-				if (i == player.internalMapIcons.end())
-				{
-					player.discoveredMapIcons.insert(std::make_pair(std::make_pair(m->second->priority, distance), m->second));
-				}
-				else
+				discoverMapIcon(player, *m, true);
+			}
+		}
+		else
+		{
+			if (cachedCell)
+			{
+				clearCachedCell(*cachedCell);
+				cachedCell->version = (*c)->version;
+			}
+			FilteredCell<Item::SharedMapIcon> &filteredCell = filterCellItems(player, filteredMapIconCells, *c, (*c)->mapIcons, core->getData()->conditionVersion, uncachedCell);
+			for (std::vector<Item::SharedMapIcon>::const_iterator m = filteredCell.items.begin(); m != filteredCell.items.end(); ++m)
+			{
+				bool satisfied = doesPlayerSatisfyConditions((*m)->players, player.playerID, (*m)->areas, player.internalAreas, (*m)->inverseAreaChecking);
+				if (satisfied && cachedCell)
 				{
-					if (m->second->cell)
+					if ((*c)->level >= 0 && (*m)->comparableStreamDistance >= STREAMER_STATIC_DISTANCE_CUTOFF)
 					{
-						player.visibleCell->mapIcons.insert(*m);
+						packCachedItem(*cachedCell, *m, (*m)->mapIconID, Eigen::Vector3f((*m)->position + (*m)->positionOffset));
+					}
+					else
+					{
+						cachedCell->items.push_back(*m);
 					}
-					player.existingMapIcons.insert(std::make_pair(std::make_pair(m->second->priority, distance), m->second));
 				}
+				discoverMapIcon(player, *m, satisfied);
 			}
-			else
+			for (std::vector<int>::const_iterator i = filteredCell.excludedIDs.begin(); i != filteredCell.excludedIDs.end(); ++i)
 			{
-				if (i != player.internalMapIcons.end())
+				if (player.streamedMapIcons.contains(*i))
 				{
-					player.removedMapIcons.push_back(i->first);
+					player.removedMapIcons.push(*i);
 				}
 			}
 		}
 	}
+	eraseStaleCachedCells(player, player.cachedMapIconCells);
+	selectCandidates(player.discoveredMapIcons, player.existingMapIcons, player.maxVisibleMapIcons);
 	if (!player.discoveredMapIcons.empty() || !player.removedMapIcons.empty())
 	{
 		player.processingChunks.set(STREAMER_TYPE_MAP_ICON);
 	}
 }
 
+void Streamer::discoverMapIcon(Player &player, const Item::SharedMapIcon &mapIcon, bool satisfied)
+{
+	float distance = std::numeric_limits<float>::infinity();
+	if (satisfied)
+	{
+		if (mapIcon->comparableStreamDistance < STREAMER_STATIC_DISTANCE_CUTOFF)
+		{
+			distance = std::numeric_limits<float>::infinity() * -1.0f;
+		}
+		else
+		{
+			distance = static_cast<float>(boost::geometry::comparable_distance(player.position, Eigen::Vector3f(mapIcon->position + mapIcon->positionOffset)));
+		}
+	}
+	discoverMapIconAtDistance(player, mapIcon, distance);
+}
+
+void Streamer::discoverMapIconAtDistance(Player &player, const Item::SharedMapIcon &mapIcon, float distance)
+{
+	bool streamed = player.streamedMapIcons.contains(mapIcon->mapIconID);
+	if (distance < (mapIcon->comparableStreamDistance * player.radiusMultipliers[STREAMER_TYPE_MAP_ICON]))
+	{
+		if (!streamed)
+		{
+			player.discoveredMapIcons.push_back(std::make_pair(std::make_pair(mapIcon->priority, distance), mapIcon));
+		}
+		else
+		{
+			if (mapIcon->cell)
+			{
+				player.visibleCell->mapIcons.insert(std::make_pair(mapIcon->mapIconID, mapIcon));
+			}
+			player.existingMapIcons.push_back(std::make_pair(std::make_pair(mapIcon->priority, distance), mapIcon));
+		}
+	}
+	else
+	{
+		if (streamed)
+		{
+			player.removedMapIcons.push(mapIcon->mapIconID);
+		}
+	}
+}
+
 void Streamer::streamMapIcons(Player &player, bool automatic)
 {
 	if (!automatic || ++player.chunkTickCount[STREAMER_TYPE_MAP_ICON] >= player.chunkTickRate[STREAMER_TYPE_MAP_ICON])
 	{
-		std::size_t chunkCount = 0;
+		std::size_t chunkBytes = 0, chunkCount = 0;
 		if (!player.removedMapIcons.empty())
 		{
-			std::vector<int>::iterator r = player.removedMapIcons.begin();
-			while (r != player.removedMapIcons.end())
+			while (!player.removedMapIcons.empty())
 			{
-				if (automatic && ++chunkCount > chunkSize[STREAMER_TYPE_MAP_ICON])
+				if (automatic && (++chunkCount > chunkSize[STREAMER_TYPE_MAP_ICON] || !isWithinChunkByteBudget(player, STREAMER_TYPE_MAP_ICON, chunkBytes, STREAMER_COST_REMOVE_MAP_ICON)))
 				{
 					break;
 				}
-				boost::unordered_map<int, int>::iterator i = player.internalMapIcons.find(*r);
+				int removedID = player.removedMapIcons.pop();
+				boost::unordered_map<int, int>::iterator i = player.internalMapIcons.find(removedID);
 				if (i != player.internalMapIcons.end())
 				{
 					sampgdk::RemovePlayerMapIcon(player.playerID, i->second);
-					boost::unordered_map<int, Item::SharedMapIcon>::iterator m = core->getData()->mapIcons.find(*r);
+					chunkBytes += STREAMER_COST_REMOVE_MAP_ICON;
+					boost::unordered_map<int, Item::SharedMapIcon>::iterator m = core->getData()->mapIcons.find(removedID);
 					if (m != core->getData()->mapIcons.end())
 					{
 						if (m->second->streamCallbacks)
 						{
-							streamOutCallbacks.push_back(boost::make_tuple(STREAMER_TYPE_MAP_ICON, *r));
+							streamOutCallbacks.push_back(boost::make_tuple(STREAMER_TYPE_MAP_ICON, removedID));
 						}
 					}
 					player.mapIconIdentifier.remove(i->second, player.internalMapIcons.size());
+					player.streamedMapIcons.erase(i->first);
 					player.internalMapIcons.quick_erase(i);
 				}
-				r = player.removedMapIcons.erase(r);
 			}
 		}
 		else
 		{
-			std::multimap<std::pair<int, float>, Item::SharedMapIcon, Item::Compare>::iterator d = player.discoveredMapIcons.begin();
-			while (d != player.discoveredMapIcons.end())
+			std::vector<std::pair<std::pair<int, float>, Item::SharedMapIcon> >::reverse_iterator d = player.discoveredMapIcons.rbegin();
+			while (d != player.discoveredMapIcons.rend())
 			{
-				if (automatic && ++chunkCount > chunkSize[STREAMER_TYPE_MAP_ICON])
+				std::size_t itemBytes = STREAMER_COST_SET_MAP_ICON;
+				if (player.internalMapIcons.size() == player.maxVisibleMapIcons && !player.existingMapIcons.empty() && isSwapCandidate(player.existingMapIcons.back().first, d->first))
+				{
+					itemBytes += STREAMER_COST_REMOVE_MAP_ICON;
+				}
+				if (automatic && (++chunkCount > chunkSize[STREAMER_TYPE_MAP_ICON] || !isWithinChunkByteBudget(player, STREAMER_TYPE_MAP_ICON, chunkBytes, itemBytes)))
 				{
 					break;
 				}
 				boost::unordered_map<int, Item::SharedMapIcon>::iterator m = core->getData()->mapIcons.find(d->second->mapIconID);
 				if (m == core->getData()->mapIcons.end())
 				{
-					player.discoveredMapIcons.erase(d++);
+					player.discoveredMapIcons.pop_back();
+					d = player.discoveredMapIcons.rbegin();
 					continue;
 				}
 				if (player.internalMapIcons.size() == player.maxVisibleMapIcons)
 				{
-					std::multimap<std::pair<int, float>, Item::SharedMapIcon, Item::Compare>::reverse_iterator e = player.existingMapIcons.rbegin();
+					std::vector<std::pair<std::pair<int, float>, Item::SharedMapIcon> >::reverse_iterator e = player.existingMapIcons.rbegin();
 					if (e != player.existingMapIcons.rend())
 					{
-						if (e->first.first < d->first.first || (e->first.second > STREAMER_STATIC_DISTANCE_CUTOFF && d->first.second < e->first.second))
+						if (isSwapCandidate(e->first, d->first))
 						{
 							boost::unordered_map<int, int>::iterator i = player.internalMapIcons.find(e->second->mapIconID);
 							if (i != player.internalMapIcons.end())
 							{
 								sampgdk::RemovePlayerMapIcon(player.playerID, i->second);
+								chunkBytes += STREAMER_COST_REMOVE_MAP_ICON;
 								if (e->second->streamCallbacks)
 								{
 									streamOutCallbacks.push_back(boost::make_tuple(STREAMER_TYPE_MAP_ICON, e->second->mapIconID));
 								}
 								player.mapIconIdentifier.remove(i->second, player.internalMapIcons.size());
+								player.streamedMapIcons.erase(i->first);
 								player.internalMapIcons.quick_erase(i);
 							}
 							if (e->second->cell)
 							{
 								player.visibleCell->mapIcons.erase(e->second->mapIconID);
 							}
-							player.existingMapIcons.erase(--e.base());
+							player.existingMapIcons.pop_back();
 						}
 					}
 					if (player.internalMapIcons.size() == player.maxVisibleMapIcons)
@@ -1020,14 +1247,18 @@ void Streamer::streamMapIcons(Player &player, bool automatic)
 				{
 					streamInCallbacks.push_back(boost::make_tuple(STREAMER_TYPE_MAP_ICON, d->second->mapIconID));
 				}
+				chunkBytes += itemBytes;
 				player.internalMapIcons.insert(std::make_pair(d->second->mapIconID, internalID));
+				player.streamedMapIcons.insert(d->second->mapIconID);
 				if (d->second->cell)
 				{
 					player.visibleCell->mapIcons.insert(std::make_pair(d->second->mapIconID, d->second));
 				}
-				player.discoveredMapIcons.erase(d++);
+				player.discoveredMapIcons.pop_back();
+				d = player.discoveredMapIcons.rbegin();
 			}
 		}
+		player.chunkBytes[STREAMER_TYPE_MAP_ICON] = chunkBytes;
 		player.chunkTickCount[STREAMER_TYPE_MAP_ICON] = 0;
 	}
 	if (player.discoveredMapIcons.empty() && player.removedMapIcons.empty())
@@ -1039,128 +1270,236 @@ void Streamer::streamMapIcons(Player &player, bool automatic)
 
 void Streamer::discoverObjects(Player &player, const std::vector<SharedCell> &cells)
 {
+	FilteredCell<Item::SharedObject> uncachedCell;
 	for (std::vector<SharedCell>::const_iterator c = cells.begin(); c != cells.end(); ++c)
 	{
-		for (boost::unordered_map<int, Item::SharedObject>::const_iterator o = (*c)->objects.begin(); o != (*c)->objects.end(); ++o)
+		CachedCell<Item::SharedObject> *cachedCell = findCachedCell(player, player.cachedObjectCells, *c);
+		if (cachedCell && cachedCell->version == (*c)->version)
 		{
-			float distance = std::numeric_limits<float>::infinity();
-			if (doesPlayerSatisfyConditions(o->second->players, player.playerID, o->second->interiors, player.interiorID, o->second->worlds, player.worldID, o->second->areas, player.internalAreas, o->second->inverseAreaChecking))
+			calculatePackedDistances(player, *cachedCell, player.radiusMultipliers[STREAMER_TYPE_OBJECT], player.streamedObjects, player.removedObjects);
+			for (std::vector<std::size_t>::const_iterator i = cachedCell->packedCandidates.begin(); i != cachedCell->packedCandidates.end(); ++i)
 			{
-				if (o->second->comparableStreamDistance < STREAMER_STATIC_DISTANCE_CUTOFF)
+				if (cachedCell->packedDistances[*i] < (cachedCell->packedStreamDistances[*i] * player.radiusMultipliers[STREAMER_TYPE_OBJECT]))
 				{
-					distance = std::numeric_limits<float>::infinity() * -1.0f;
+					discoverObjectAtDistance(player, cachedCell->packedItems[*i], cachedCell->packedDistances[*i]);
 				}
 				else
 				{
-					if (o->second->attach)
+					if (player.streamedObjects.contains(cachedCell->packedIDs[*i]))
 					{
-						distance = static_cast<float>(boost::geometry::comparable_distance(player.position, o->second->attach->position) + std::numeric_limits<float>::epsilon());
-					}
-					else
-					{
-						distance = static_cast<float>(boost::geometry::comparable_distance(player.position, Eigen::Vector3f(o->second->position + o->second->positionOffset)));
+						player.removedObjects.push(cachedCell->packedIDs[*i]);
 					}
 				}
 			}
-			boost::unordered_map<int, int>::iterator i = player.internalObjects.find(o->first);
-			if (distance < (o->second->comparableStreamDistance * player.radiusMultipliers[STREAMER_TYPE_OBJECT]))
+			for (std::vector<Item::SharedObject>::const_iterator o = cachedCell->items.begin(); o != cachedCell->items.end(); ++o)
 			{
-				if (i == player.internalObjects.end())
-				{
-					player.discoveredObjects.insert(std::make_pair(std::make_pair(o->second->priority, distance), o->second));
-				}
-				else
+				discoverObject(player, *o, true);
+			}
+		}
+		else
+		{
+			if (cachedCell)
+			{
+				clearCachedCell(*cachedCell);
+				cachedCell->version = (*c)->version;
+			}
+			FilteredCell<Item::SharedObject> &filteredCell = filterCellItems(player, filteredObjectCells, *c, (*c)->objects, core->getData()->conditionVersion, uncachedCell);
+			for (std::vector<Item::SharedObject>::const_iterator o = filteredCell.items.begin(); o != filteredCell.items.end(); ++o)
+			{
+				bool satisfied = doesPlayerSatisfyConditions((*o)->players, player.playerID, (*o)->areas, player.internalAreas, (*o)->inverseAreaChecking);
+				if (satisfied && cachedCell)
 				{
-					if (o->second->cell)
+					if ((*c)->level >= 0 && !(*o)->attach && !(*o)->move && (*o)->comparableStreamDistance >= STREAMER_STATIC_DISTANCE_CUTOFF)
+					{
+						packCachedItem(*cachedCell, *o, (*o)->objectID, Eigen::Vector3f((*o)->position + (*o)->positionOffset));
+					}
+					else
 					{
-						player.visibleCell->objects.insert(*o);
+						cachedCell->items.push_back(*o);
 					}
-					player.existingObjects.insert(std::make_pair(std::make_pair(o->second->priority, distance), o->second));
 				}
+				discoverObject(player, *o, satisfied);
 			}
-			else
+			for (std::vector<int>::const_iterator i = filteredCell.excludedIDs.begin(); i != filteredCell.excludedIDs.end(); ++i)
 			{
-				if (i != player.internalObjects.end())
+				if (player.streamedObjects.contains(*i))
 				{
-					player.removedObjects.push_back(i->first);
+					player.removedObjects.push(*i);
 				}
 			}
 		}
 	}
+	eraseStaleCachedCells(player, player.cachedObjectCells);
+	selectCandidates(player.discoveredObjects, player.existingObjects, player.maxVisibleObjects);
 	if (!player.discoveredObjects.empty() || !player.removedObjects.empty())
 	{
 		player.processingChunks.set(STREAMER_TYPE_OBJECT);
 	}
 }
 
-void Streamer::streamObjects(Player &player, bool automatic)
+void Streamer::discoverObject(Player &player, const Item::SharedObject &object, bool satisfied)
 {
-	if (!automatic || ++player.chunkTickCount[STREAMER_TYPE_OBJECT] >= player.chunkTickRate[STREAMER_TYPE_OBJECT])
+	float distance = std::numeric_limits<float>::infinity();
+	if (satisfied)
 	{
-		std::size_t chunkCount = 0;
-		if (!player.removedObjects.empty())
+		if (object->comparableStreamDistance < STREAMER_STATIC_DISTANCE_CUTOFF)
 		{
-			std::vector<int>::iterator r = player.removedObjects.begin();
-			while (r != player.removedObjects.end())
-			{
-				if (automatic && ++chunkCount > chunkSize[STREAMER_TYPE_OBJECT])
-				{
-					break;
-				}
-				boost::unordered_map<int, int>::iterator i = player.internalObjects.find(*r);
-				if (i != player.internalObjects.end())
-				{
-					sampgdk::DestroyPlayerObject(player.playerID, i->second);
-					boost::unordered_map<int, Item::SharedObject>::iterator o = core->getData()->objects.find(*r);
-					if (o != core->getData()->objects.end())
-					{
-						if (o->second->streamCallbacks)
-						{
-							streamOutCallbacks.push_back(boost::make_tuple(STREAMER_TYPE_OBJECT, *r));
-						}
-					}
-					player.internalObjects.quick_erase(i);
-				}
-				r = player.removedObjects.erase(r);
-			}
+			distance = std::numeric_limits<float>::infinity() * -1.0f;
 		}
 		else
 		{
-			std::multimap<std::pair<int, float>, Item::SharedObject, Item::Compare>::iterator d = player.discoveredObjects.begin();
-			while (d != player.discoveredObjects.end())
+			if (object->attach)
+			{
+				distance = static_cast<float>(boost::geometry::comparable_distance(player.position, object->attach->position) + std::numeric_limits<float>::epsilon());
+			}
+			else
 			{
-				if (automatic && ++chunkCount > chunkSize[STREAMER_TYPE_OBJECT])
+				if (object->move)
+				{
+					updateObjectMove(object, objectMoveTime);
+				}
+				distance = static_cast<float>(boost::geometry::comparable_distance(player.position, Eigen::Vector3f(object->position + object->positionOffset)));
+			}
+		}
+	}
+	discoverObjectAtDistance(player, object, distance);
+}
+
+void Streamer::discoverObjectAtDistance(Player &player, const Item::SharedObject &object, float distance)
+{
+	bool streamed = player.streamedObjects.contains(object->objectID);
+	if (distance < (object->comparableStreamDistance * player.radiusMultipliers[STREAMER_TYPE_OBJECT]))
+	{
+		if (!streamed)
+		{
+			player.discoveredObjects.push_back(std::make_pair(std::make_pair(object->priority, distance), object));
+		}
+		else
+		{
+			if (object->cell)
+			{
+				player.visibleCell->objects.insert(std::make_pair(object->objectID, object));
+			}
+			player.existingObjects.push_back(std::make_pair(std::make_pair(object->priority, distance), object));
+		}
+	}
+	else
+	{
+		if (streamed)
+		{
+			player.removedObjects.push(object->objectID);
+		}
+	}
+}
+
+std::size_t Streamer::estimateObjectBytes(const Item::SharedObject &object)
+{
+	std::size_t bytes = STREAMER_COST_CREATE_OBJECT;
+	if (object->attach)
+	{
+		bytes += STREAMER_COST_ATTACH_OBJECT;
+	}
+	else if (object->move)
+	{
+		bytes += STREAMER_COST_MOVE_OBJECT;
+	}
+	for (boost::unordered_map<int, Item::Object::Material>::const_iterator m = object->materials.begin(); m != object->materials.end(); ++m)
+	{
+		if (m->second.main)
+		{
+			bytes += STREAMER_COST_OBJECT_MATERIAL + m->second.main->txdFileName.size() + m->second.main->textureName.size();
+		}
+		else if (m->second.text)
+		{
+			bytes += STREAMER_COST_OBJECT_MATERIAL_TEXT + m->second.text->materialText.size() + m->second.text->fontFace.size();
+		}
+	}
+	if (object->noCameraCollision)
+	{
+		bytes += STREAMER_COST_OBJECT_NO_CAMERA_COL;
+	}
+	return bytes;
+}
+
+void Streamer::streamObjects(Player &player, bool automatic)
+{
+	if (!automatic || ++player.chunkTickCount[STREAMER_TYPE_OBJECT] >= player.chunkTickRate[STREAMER_TYPE_OBJECT])
+	{
+		std::size_t chunkBytes = 0, chunkCount = 0;
+		if (!player.removedObjects.empty())
+		{
+			while (!player.removedObjects.empty())
+			{
+				if (automatic && (++chunkCount > chunkSize[STREAMER_TYPE_OBJECT] || !isWithinChunkByteBudget(player, STREAMER_TYPE_OBJECT, chunkBytes, STREAMER_COST_DESTROY_OBJECT)))
+				{
+					break;
+				}
+				int removedID = player.removedObjects.pop();
+				boost::unordered_map<int, int>::iterator i = player.internalObjects.find(removedID);
+				if (i != player.internalObjects.end())
+				{
+					sampgdk::DestroyPlayerObject(player.playerID, i->second);
+					chunkBytes += STREAMER_COST_DESTROY_OBJECT;
+					boost::unordered_map<int, Item::SharedObject>::iterator o = core->getData()->objects.find(removedID);
+					if (o != core->getData()->objects.end())
+					{
+						if (o->second->streamCallbacks)
+						{
+							streamOutCallbacks.push_back(boost::make_tuple(STREAMER_TYPE_OBJECT, removedID));
+						}
+					}
+					player.streamedObjects.erase(i->first);
+					player.reverseObjects.erase(i->second);
+					player.internalObjects.quick_erase(i);
+				}
+			}
+		}
+		else
+		{
+			std::vector<std::pair<std::pair<int, float>, Item::SharedObject> >::reverse_iterator d = player.discoveredObjects.rbegin();
+			while (d != player.discoveredObjects.rend())
+			{
+				std::size_t itemBytes = estimateObjectBytes(d->second);
+				if (player.internalObjects.size() == player.currentVisibleObjects && !player.existingObjects.empty() && isSwapCandidate(player.existingObjects.back().first, d->first))
+				{
+					itemBytes += STREAMER_COST_DESTROY_OBJECT;
+				}
+				if (automatic && (++chunkCount > chunkSize[STREAMER_TYPE_OBJECT] || !isWithinChunkByteBudget(player, STREAMER_TYPE_OBJECT, chunkBytes, itemBytes)))
 				{
 					break;
 				}
 				boost::unordered_map<int, Item::SharedObject>::iterator o = core->getData()->objects.find(d->second->objectID);
 				if (o == core->getData()->objects.end())
 				{
-					player.discoveredObjects.erase(d++);
+					player.discoveredObjects.pop_back();
+					d = player.discoveredObjects.rbegin();
 					continue;
 				}
 				if (player.internalObjects.size() == player.currentVisibleObjects)
 				{
-					std::multimap<std::pair<int, float>, Item::SharedObject, Item::Compare>::reverse_iterator e = player.existingObjects.rbegin();
+					std::vector<std::pair<std::pair<int, float>, Item::SharedObject> >::reverse_iterator e = player.existingObjects.rbegin();
 					if (e != player.existingObjects.rend())
 					{
-						if (e->first.first < d->first.first || (e->first.second > STREAMER_STATIC_DISTANCE_CUTOFF && d->first.second < e->first.second))
+						if (isSwapCandidate(e->first, d->first))
 						{
 							boost::unordered_map<int, int>::iterator i = player.internalObjects.find(e->second->objectID);
 							if (i != player.internalObjects.end())
 							{
 								sampgdk::DestroyPlayerObject(player.playerID, i->second);
+								chunkBytes += STREAMER_COST_DESTROY_OBJECT;
 								if (e->second->streamCallbacks)
 								{
 									streamOutCallbacks.push_back(boost::make_tuple(STREAMER_TYPE_OBJECT, e->second->objectID));
 								}
+								player.streamedObjects.erase(i->first);
+								player.reverseObjects.erase(i->second);
 								player.internalObjects.quick_erase(i);
 							}
 							if (e->second->cell)
 							{
 								player.visibleCell->objects.erase(e->second->objectID);
 							}
-							player.existingObjects.erase(--e.base());
+							player.existingObjects.pop_back();
 						}
 					}
 				}
@@ -1188,7 +1527,7 @@ void Streamer::streamObjects(Player &player, bool automatic)
 						boost::unordered_map<int, int>::iterator i = player.internalObjects.find(d->second->attach->object);
 						if (i != player.internalObjects.end())
 						{
-							AMX_NATIVE native = sampgdk::FindNative("AttachPlayerObjectToObject");
+							AMX_NATIVE native = Utility::findNative(STREAMER_NATIVE_ATTACH_PLAYER_OBJECT_TO_OBJECT);
 							if (native != NULL)
 							{
 								sampgdk::InvokeNative(native, "dddffffffb", player.playerID, internalID, i->second, d->second->attach->positionOffset[0], d->second->attach->positionOffset[1], d->second->attach->positionOffset[2], d->second->attach->rotation[0], d->second->attach->rotation[1], d->second->attach->rotation[2], d->second->attach->syncRotation);
@@ -1197,7 +1536,7 @@ void Streamer::streamObjects(Player &player, bool automatic)
 					}
 					else if (d->second->attach->player != INVALID_GENERIC_ID)
 					{
-						AMX_NATIVE native = sampgdk::FindNative("AttachPlayerObjectToPlayer");
+						AMX_NATIVE native = Utility::findNative(STREAMER_NATIVE_ATTACH_PLAYER_OBJECT_TO_PLAYER);
 						if (native != NULL)
 						{
 							sampgdk::InvokeNative(native, "dddffffffd", player.playerID, internalID, d->second->attach->player, d->second->attach->positionOffset[0], d->second->attach->positionOffset[1], d->second->attach->positionOffset[2], d->second->attach->rotation[0], d->second->attach->rotation[1], d->second->attach->rotation[2], 1);
@@ -1238,14 +1577,19 @@ void Streamer::streamObjects(Player &player, bool automatic)
 				{
 					sampgdk::SetPlayerObjectNoCameraCol(player.playerID, internalID);
 				}
+				chunkBytes += itemBytes;
 				player.internalObjects.insert(std::make_pair(d->second->objectID, internalID));
+				player.streamedObjects.insert(d->second->objectID);
+				player.reverseObjects.insert(internalID, d->second->objectID);
 				if (d->second->cell)
 				{
 					player.visibleCell->objects.insert(std::make_pair(d->second->objectID, d->second));
 				}
-				player.discoveredObjects.erase(d++);
+				player.discoveredObjects.pop_back();
+				d = player.discoveredObjects.rbegin();
 			}
 		}
+		player.chunkBytes[STREAMER_TYPE_OBJECT] = chunkBytes;
 		player.chunkTickCount[STREAMER_TYPE_OBJECT] = 0;
 	}
 	if (player.discoveredObjects.empty() && player.removedObjects.empty())
@@ -1261,58 +1605,106 @@ void Streamer::discoverPickups(Player &player, const std::vector<SharedCell> &ce
 	{
 		for (boost::unordered_map<int, Item::SharedPickup>::const_iterator p = (*c)->pickups.begin(); p != (*c)->pickups.end(); ++p)
 		{
-			boost::unordered_map<int, Item::SharedPickup>::iterator d = core->getData()->discoveredPickups.find(p->first);
-			if (d == core->getData()->discoveredPickups.end())
+			if (doesPlayerSatisfyConditions(p->second->players, player.playerID, p->second->interiors, player.interiorID, p->second->worlds, player.worldID, p->second->areas, player.internalAreas, p->second->inverseAreaChecking))
 			{
-				if (doesPlayerSatisfyConditions(p->second->players, player.playerID, p->second->interiors, player.interiorID, p->second->worlds, player.worldID, p->second->areas, player.internalAreas, p->second->inverseAreaChecking))
+				if (p->second->comparableStreamDistance < STREAMER_STATIC_DISTANCE_CUTOFF || boost::geometry::comparable_distance(player.position, Eigen::Vector3f(p->second->position + p->second->positionOffset)) < (p->second->comparableStreamDistance * player.radiusMultipliers[STREAMER_TYPE_PICKUP]))
 				{
-					if (p->second->comparableStreamDistance < STREAMER_STATIC_DISTANCE_CUTOFF || boost::geometry::comparable_distance(player.position, Eigen::Vector3f(p->second->position + p->second->positionOffset)) < (p->second->comparableStreamDistance * player.radiusMultipliers[STREAMER_TYPE_PICKUP]))
+					std::pair<boost::unordered_map<int, std::size_t>::iterator, bool> r = player.referencedPickups.insert(std::make_pair(p->first, player.referenceUpdate));
+					if (r.second)
 					{
-						boost::unordered_map<int, int>::iterator i = core->getData()->internalPickups.find(p->first);
-						if (i == core->getData()->internalPickups.end())
-						{
-							p->second->worldID = !p->second->worlds.empty() ? player.worldID : -1;
-						}
-						core->getData()->discoveredPickups.insert(*p);
+						addPickupReference(player, p->second);
+					}
+					else
+					{
+						r.first->second = player.referenceUpdate;
 					}
 				}
 			}
 		}
 	}
-	player.checkedPickups = true;
+	boost::unordered_map<int, std::size_t>::iterator r = player.referencedPickups.begin();
+	while (r != player.referencedPickups.end())
+	{
+		if (r->second != player.referenceUpdate)
+		{
+			removePickupReference(r->first);
+			r = player.referencedPickups.erase(r);
+		}
+		else
+		{
+			++r;
+		}
+	}
+}
+
+void Streamer::addPickupReference(Player &player, const Item::SharedPickup &pickup)
+{
+	if (++core->getData()->pickupReferences[pickup->pickupID] == 1)
+	{
+		if (core->getData()->internalPickups.find(pickup->pickupID) == core->getData()->internalPickups.end())
+		{
+			pickup->worldID = !pickup->worlds.empty() ? player.worldID : -1;
+			core->getData()->discoveredPickups.insert(std::make_pair(pickup->pickupID, pickup));
+		}
+	}
+}
+
+void Streamer::removePickupReference(int pickupID)
+{
+	boost::unordered_map<int, std::size_t>::iterator r = core->getData()->pickupReferences.find(pickupID);
+	if (r != core->getData()->pickupReferences.end())
+	{
+		if (!--r->second)
+		{
+			core->getData()->pickupReferences.quick_erase(r);
+			core->getData()->discoveredPickups.erase(pickupID);
+			core->getData()->releasedPickups.push_back(pickupID);
+		}
+	}
+}
+
+void Streamer::releasePickupReferences(Player &player)
+{
+	for (boost::unordered_map<int, std::size_t>::const_iterator r = player.referencedPickups.begin(); r != player.referencedPickups.end(); ++r)
+	{
+		removePickupReference(r->first);
+	}
+	player.referencedPickups.clear();
 }
 
 void Streamer::streamPickups()
 {
-	boost::unordered_map<int, int>::iterator i = core->getData()->internalPickups.begin();
-	while (i != core->getData()->internalPickups.end())
+	for (std::vector<int>::const_iterator r = core->getData()->releasedPickups.begin(); r != core->getData()->releasedPickups.end(); ++r)
 	{
-		boost::unordered_map<int, Item::SharedPickup>::iterator d = core->getData()->discoveredPickups.find(i->first);
-		if (d == core->getData()->discoveredPickups.end())
+		if (core->getData()->pickupReferences.find(*r) == core->getData()->pickupReferences.end())
 		{
-			sampgdk::DestroyPickup(i->second);
-			boost::unordered_map<int, Item::SharedPickup>::iterator p = core->getData()->pickups.find(i->first);
-			if (p != core->getData()->pickups.end())
+			boost::unordered_map<int, int>::iterator i = core->getData()->internalPickups.find(*r);
+			if (i != core->getData()->internalPickups.end())
 			{
-				if (p->second->streamCallbacks)
+				sampgdk::DestroyPickup(i->second);
+				boost::unordered_map<int, Item::SharedPickup>::iterator p = core->getData()->pickups.find(i->first);
+				if (p != core->getData()->pickups.end())
 				{
-					streamOutCallbacks.push_back(boost::make_tuple(STREAMER_TYPE_PICKUP, i->first));
+					if (p->second->streamCallbacks)
+					{
+						streamOutCallbacks.push_back(boost::make_tuple(STREAMER_TYPE_PICKUP, i->first));
+					}
 				}
+				core->getData()->reversePickups.erase(i->second);
+				core->getData()->internalPickups.quick_erase(i);
 			}
-			i = core->getData()->internalPickups.erase(i);
-		}
-		else
-		{
-			core->getData()->discoveredPickups.erase(d);
-			++i;
 		}
 	}
+	core->getData()->releasedPickups.clear();
+	if (core->getData()->discoveredPickups.empty() || core->getData()->internalPickups.size() >= core->getData()->getGlobalMaxVisibleItems(STREAMER_TYPE_PICKUP))
+	{
+		return;
+	}
 	std::multimap<int, Item::SharedPickup> sortedPickups;
 	for (boost::unordered_map<int, Item::SharedPickup>::iterator d = core->getData()->discoveredPickups.begin(); d != core->getData()->discoveredPickups.end(); ++d)
 	{
 		sortedPickups.insert(std::make_pair(d->second->priority, d->second));
 	}
-	core->getData()->discoveredPickups.clear();
 	for (std::multimap<int, Item::SharedPickup>::iterator i = sortedPickups.begin(); i != sortedPickups.end(); ++i)
 	{
 		if (core->getData()->internalPickups.size() == core->getData()->getGlobalMaxVisibleItems(STREAMER_TYPE_PICKUP))
@@ -1329,10 +1721,8 @@ void Streamer::streamPickups()
 			streamInCallbacks.push_back(boost::make_tuple(STREAMER_TYPE_PICKUP, i->second->pickupID));
 		}
 		core->getData()->internalPickups.insert(std::make_pair(i->second->pickupID, internalID));
-	}
-	for (boost::unordered_map<int, Player>::iterator p = core->getData()->players.begin(); p != core->getData()->players.end(); ++p)
-	{
-		p->second.checkedPickups = false;
+		core->getData()->reversePickups.insert(internalID, i->second->pickupID);
+		core->getData()->discoveredPickups.erase(i->second->pickupID);
 	}
 }
 
@@ -1399,128 +1789,208 @@ void Streamer::processRaceCheckpoints(Player &player, const std::vector<SharedCe
 
 void Streamer::discoverTextLabels(Player &player, const std::vector<SharedCell> &cells)
 {
+	FilteredCell<Item::SharedTextLabel> uncachedCell;
 	for (std::vector<SharedCell>::const_iterator c = cells.begin(); c != cells.end(); ++c)
 	{
-		for (boost::unordered_map<int, Item::SharedTextLabel>::const_iterator t = (*c)->textLabels.begin(); t != (*c)->textLabels.end(); ++t)
+		CachedCell<Item::SharedTextLabel> *cachedCell = findCachedCell(player, player.cachedTextLabelCells, *c);
+		if (cachedCell && cachedCell->version == (*c)->version)
 		{
-			float distance = std::numeric_limits<float>::infinity();
-			if (doesPlayerSatisfyConditions(t->second->players, player.playerID, t->second->interiors, player.interiorID, t->second->worlds, player.worldID, t->second->areas, player.internalAreas, t->second->inverseAreaChecking))
+			calculatePackedDistances(player, *cachedCell, player.radiusMultipliers[STREAMER_TYPE_3D_TEXT_LABEL], player.streamedTextLabels, player.removedTextLabels);
+			for (std::vector<std::size_t>::const_iterator i = cachedCell->packedCandidates.begin(); i != cachedCell->packedCandidates.end(); ++i)
 			{
-				if (t->second->comparableStreamDistance < STREAMER_STATIC_DISTANCE_CUTOFF)
+				if (cachedCell->packedDistances[*i] < (cachedCell->packedStreamDistances[*i] * player.radiusMultipliers[STREAMER_TYPE_3D_TEXT_LABEL]))
 				{
-					distance = std::numeric_limits<float>::infinity() * -1.0f;
+					discoverTextLabelAtDistance(player, cachedCell->packedItems[*i], cachedCell->packedDistances[*i]);
 				}
 				else
 				{
-					if (t->second->attach)
-					{
-						distance = static_cast<float>(boost::geometry::comparable_distance(player.position, t->second->attach->position));
-					}
-					else
+					if (player.streamedTextLabels.contains(cachedCell->packedIDs[*i]))
 					{
-						distance = static_cast<float>(boost::geometry::comparable_distance(player.position, Eigen::Vector3f(t->second->position + t->second->positionOffset)));
+						player.removedTextLabels.push(cachedCell->packedIDs[*i]);
 					}
 				}
 			}
-			boost::unordered_map<int, int>::iterator i = player.internalTextLabels.find(t->first);
-			if (distance < (t->second->comparableStreamDistance * player.radiusMultipliers[STREAMER_TYPE_3D_TEXT_LABEL]))
+			for (std::vector<Item::SharedTextLabel>::const_iterator t = cachedCell->items.begin(); t != cachedCell->items.end(); ++t)
 			{
-				if (i == player.internalTextLabels.end())
-				{
-					player.discoveredTextLabels.insert(std::make_pair(std::make_pair(t->second->priority, distance), t->second));
-				}
-				else
+				discoverTextLabel(player, *t, true);
+			}
+		}
+		else
+		{
+			if (cachedCell)
+			{
+				clearCachedCell(*cachedCell);
+				cachedCell->version = (*c)->version;
+			}
+			FilteredCell<Item::SharedTextLabel> &filteredCell = filterCellItems(player, filteredTextLabelCells, *c, (*c)->textLabels, core->getData()->conditionVersion, uncachedCell);
+			for (std::vector<Item::SharedTextLabel>::const_iterator t = filteredCell.items.begin(); t != filteredCell.items.end(); ++t)
+			{
+				bool satisfied = doesPlayerSatisfyConditions((*t)->players, player.playerID, (*t)->areas, player.internalAreas, (*t)->inverseAreaChecking);
+				if (satisfied && cachedCell)
 				{
-					if (t->second->cell)
+					if ((*c)->level >= 0 && !(*t)->attach && (*t)->comparableStreamDistance >= STREAMER_STATIC_DISTANCE_CUTOFF)
+					{
+						packCachedItem(*cachedCell, *t, (*t)->textLabelID, Eigen::Vector3f((*t)->position + (*t)->positionOffset));
+					}
+					else
 					{
-						player.visibleCell->textLabels.insert(*t);
+						cachedCell->items.push_back(*t);
 					}
-					player.existingTextLabels.insert(std::make_pair(std::make_pair(t->second->priority, distance), t->second));
 				}
+				discoverTextLabel(player, *t, satisfied);
 			}
-			else
+			for (std::vector<int>::const_iterator i = filteredCell.excludedIDs.begin(); i != filteredCell.excludedIDs.end(); ++i)
 			{
-				if (i != player.internalTextLabels.end())
+				if (player.streamedTextLabels.contains(*i))
 				{
-					player.removedTextLabels.push_back(i->first);
+					player.removedTextLabels.push(*i);
 				}
 			}
 		}
 	}
+	eraseStaleCachedCells(player, player.cachedTextLabelCells);
+	selectCandidates(player.discoveredTextLabels, player.existingTextLabels, player.maxVisibleTextLabels);
 	if (!player.discoveredTextLabels.empty() || !player.removedTextLabels.empty())
 	{
 		player.processingChunks.set(STREAMER_TYPE_3D_TEXT_LABEL);
 	}
 }
 
+void Streamer::discoverTextLabel(Player &player, const Item::SharedTextLabel &textLabel, bool satisfied)
+{
+	float distance = std::numeric_limits<float>::infinity();
+	if (satisfied)
+	{
+		if (textLabel->comparableStreamDistance < STREAMER_STATIC_DISTANCE_CUTOFF)
+		{
+			distance = std::numeric_limits<float>::infinity() * -1.0f;
+		}
+		else
+		{
+			if (textLabel->attach)
+			{
+				distance = static_cast<float>(boost::geometry::comparable_distance(player.position, textLabel->attach->position));
+			}
+			else
+			{
+				distance = static_cast<float>(boost::geometry::comparable_distance(player.position, Eigen::Vector3f(textLabel->position + textLabel->positionOffset)));
+			}
+		}
+	}
+	discoverTextLabelAtDistance(player, textLabel, distance);
+}
+
+void Streamer::discoverTextLabelAtDistance(Player &player, const Item::SharedTextLabel &textLabel, float distance)
+{
+	bool streamed = player.streamedTextLabels.contains(textLabel->textLabelID);
+	if (distance < (textLabel->comparableStreamDistance * player.radiusMultipliers[STREAMER_TYPE_3D_TEXT_LABEL]))
+	{
+		if (!streamed)
+		{
+			player.discoveredTextLabels.push_back(std::make_pair(std::make_pair(textLabel->priority, distance), textLabel));
+		}
+		else
+		{
+			if (textLabel->cell)
+			{
+				player.visibleCell->textLabels.insert(std::make_pair(textLabel->textLabelID, textLabel));
+			}
+			player.existingTextLabels.push_back(std::make_pair(std::make_pair(textLabel->priority, distance), textLabel));
+		}
+	}
+	else
+	{
+		if (streamed)
+		{
+			player.removedTextLabels.push(textLabel->textLabelID);
+		}
+	}
+}
+
+std::size_t Streamer::estimateTextLabelBytes(const Item::SharedTextLabel &textLabel)
+{
+	return STREAMER_COST_CREATE_3D_TEXT_LABEL + textLabel->text.size();
+}
+
 void Streamer::streamTextLabels(Player &player, bool automatic)
 {
 	if (!automatic || ++player.chunkTickCount[STREAMER_TYPE_3D_TEXT_LABEL] >= player.chunkTickRate[STREAMER_TYPE_3D_TEXT_LABEL])
 	{
-		std::size_t chunkCount = 0;
+		std::size_t chunkBytes = 0, chunkCount = 0;
 		if (!player.removedTextLabels.empty())
 		{
-			std::vector<int>::iterator r = player.removedTextLabels.begin();
-			while (r != player.removedTextLabels.end())
+			while (!player.removedTextLabels.empty())
 			{
-				if (automatic && ++chunkCount > chunkSize[STREAMER_TYPE_3D_TEXT_LABEL])
+				if (automatic && (++chunkCount > chunkSize[STREAMER_TYPE_3D_TEXT_LABEL] || !isWithinChunkByteBudget(player, STREAMER_TYPE_3D_TEXT_LABEL, chunkBytes, STREAMER_COST_DELETE_3D_TEXT_LABEL)))
 				{
 					break;
 				}
-				boost::unordered_map<int, int>::iterator i = player.internalTextLabels.find(*r);
+				int removedID = player.removedTextLabels.pop();
+				boost::unordered_map<int, int>::iterator i = player.internalTextLabels.find(removedID);
 				if (i != player.internalTextLabels.end())
 				{
 					sampgdk::DeletePlayer3DTextLabel(player.playerID, i->second);
-					boost::unordered_map<int, Item::SharedTextLabel>::iterator t = core->getData()->textLabels.find(*r);
+					chunkBytes += STREAMER_COST_DELETE_3D_TEXT_LABEL;
+					boost::unordered_map<int, Item::SharedTextLabel>::iterator t = core->getData()->textLabels.find(removedID);
 					if (t != core->getData()->textLabels.end())
 					{
 						if (t->second->streamCallbacks)
 						{
-							streamOutCallbacks.push_back(boost::make_tuple(STREAMER_TYPE_3D_TEXT_LABEL, *r));
+							streamOutCallbacks.push_back(boost::make_tuple(STREAMER_TYPE_3D_TEXT_LABEL, removedID));
 						}
 					}
+					player.streamedTextLabels.erase(i->first);
+					player.reverseTextLabels.erase(i->second);
 					player.internalTextLabels.quick_erase(i);
 				}
-				r = player.removedTextLabels.erase(r);
 			}
 		}
 		else
 		{
-			std::multimap<std::pair<int, float>, Item::SharedTextLabel, Item::Compare>::iterator d = player.discoveredTextLabels.begin();
-			while (d != player.discoveredTextLabels.end())
+			std::vector<std::pair<std::pair<int, float>, Item::SharedTextLabel> >::reverse_iterator d = player.discoveredTextLabels.rbegin();
+			while (d != player.discoveredTextLabels.rend())
 			{
-				if (automatic && ++chunkCount > chunkSize[STREAMER_TYPE_3D_TEXT_LABEL])
+				std::size_t itemBytes = estimateTextLabelBytes(d->second);
+				if (player.internalTextLabels.size() == player.currentVisibleTextLabels && !player.existingTextLabels.empty() && isSwapCandidate(player.existingTextLabels.back().first, d->first))
+				{
+					itemBytes += STREAMER_COST_DELETE_3D_TEXT_LABEL;
+				}
+				if (automatic && (++chunkCount > chunkSize[STREAMER_TYPE_3D_TEXT_LABEL] || !isWithinChunkByteBudget(player, STREAMER_TYPE_3D_TEXT_LABEL, chunkBytes, itemBytes)))
 				{
 					break;
 				}
 				boost::unordered_map<int, Item::SharedTextLabel>::iterator t = core->getData()->textLabels.find(d->second->textLabelID);
 				if (t == core->getData()->textLabels.end())
 				{
-					player.discoveredTextLabels.erase(d++);
+					player.discoveredTextLabels.pop_back();
+					d = player.discoveredTextLabels.rbegin();
 					continue;
 				}
 				if (player.internalTextLabels.size() == player.currentVisibleTextLabels)
 				{
-					std::multimap<std::pair<int, float>, Item::SharedTextLabel, Item::Compare>::reverse_iterator e = player.existingTextLabels.rbegin();
+					std::vector<std::pair<std::pair<int, float>, Item::SharedTextLabel> >::reverse_iterator e = player.existingTextLabels.rbegin();
 					if (e != player.existingTextLabels.rend())
 					{
-						if (e->first.first < d->first.first || (e->first.second > STREAMER_STATIC_DISTANCE_CUTOFF && d->first.second < e->first.second))
+						if (isSwapCandidate(e->first, d->first))
 						{
 							boost::unordered_map<int, int>::iterator i = player.internalTextLabels.find(e->second->textLabelID);
 							if (i != player.internalTextLabels.end())
 							{
 								sampgdk::DeletePlayer3DTextLabel(player.playerID, i->second);
+								chunkBytes += STREAMER_COST_DELETE_3D_TEXT_LABEL;
 								if (e->second->streamCallbacks)
 								{
 									streamOutCallbacks.push_back(boost::make_tuple(STREAMER_TYPE_3D_TEXT_LABEL, e->second->textLabelID));
 								}
+								player.streamedTextLabels.erase(i->first);
+								player.reverseTextLabels.erase(i->second);
 								player.internalTextLabels.quick_erase(i);
 							}
 							if (e->second->cell)
 							{
 								player.visibleCell->textLabels.erase(e->second->textLabelID);
 							}
-							player.existingTextLabels.erase(--e.base());
+							player.existingTextLabels.pop_back();
 						}
 					}
 				}
@@ -1556,16 +2026,21 @@ void Streamer::streamTextLabels(Player &player, bool automatic)
 						player.currentVisibleTextLabels = player.internalTextLabels.size();
 						break;
 					}
+					chunkBytes += itemBytes;
 					player.internalTextLabels.insert(std::make_pair(d->second->textLabelID, internalID));
+					player.streamedTextLabels.insert(d->second->textLabelID);
+					player.reverseTextLabels.insert(internalID, d->second->textLabelID);
 					if (d->second->cell)
 					{
 						player.visibleCell->textLabels.insert(std::make_pair(d->second->textLabelID, d->second));
 					}
 				}
 
-				player.discoveredTextLabels.erase(d++);
+				player.discoveredTextLabels.pop_back();
+				d = player.discoveredTextLabels.rbegin();
 			}
 		}
+		player.chunkBytes[STREAMER_TYPE_3D_TEXT_LABEL] = chunkBytes;
 		player.chunkTickCount[STREAMER_TYPE_3D_TEXT_LABEL] = 0;
 	}
 	if (player.discoveredTextLabels.empty() && player.removedTextLabels.empty())
@@ -1579,81 +2054,118 @@ void Streamer::discoverVehicles(Player &player, const std::vector<SharedCell> &c
 {
 	for (std::vector<SharedCell>::const_iterator c = cells.begin(); c != cells.end(); ++c)
 	{
-		for (boost::unordered_map<int, Item::SharedVehicle>::const_iterator p = (*c)->vehicles.begin(); p != (*c)->vehicles.end(); ++p)
+		for (boost::unordered_map<int, Item::SharedVehicle>::const_iterator v = (*c)->vehicles.begin(); v != (*c)->vehicles.end(); ++v)
 		{
-			boost::unordered_map<int, Item::SharedVehicle>::iterator d = core->getData()->discoveredVehicles.find(p->first);
-			if (d == core->getData()->discoveredVehicles.end())
-			{				
-				if (doesPlayerSatisfyConditions(p->second->players, player.playerID, p->second->interior, player.interiorID, p->second->worlds, player.worldID, p->second->areas, player.internalAreas, p->second->inverseAreaChecking))
+			if (doesPlayerSatisfyConditions(v->second->players, player.playerID, v->second->interior, player.interiorID, v->second->worlds, player.worldID, v->second->areas, player.internalAreas, v->second->inverseAreaChecking))
+			{
+				if (v->second->comparableStreamDistance < STREAMER_STATIC_DISTANCE_CUTOFF || boost::geometry::comparable_distance(player.position, Eigen::Vector3f(v->second->position + v->second->positionOffset)) < (v->second->comparableStreamDistance * player.radiusMultipliers[STREAMER_TYPE_VEHICLE]))
 				{
-					if (p->second->comparableStreamDistance < STREAMER_STATIC_DISTANCE_CUTOFF || boost::geometry::comparable_distance(player.position, Eigen::Vector3f(p->second->position + p->second->positionOffset)) < (p->second->comparableStreamDistance * player.radiusMultipliers[STREAMER_TYPE_VEHICLE]))
+					std::pair<boost::unordered_map<int, std::size_t>::iterator, bool> r = player.referencedVehicles.insert(std::make_pair(v->first, player.referenceUpdate));
+					if (r.second)
 					{
-						boost::unordered_map<int, int>::iterator i = core->getData()->internalVehicles.find(p->first);
-						if (i == core->getData()->internalVehicles.end())
-						{
-							p->second->worldID = !p->second->worlds.empty() ? player.worldID : 0;
-						}
-						core->getData()->discoveredVehicles.insert(*p);
+						addVehicleReference(player, v->second);
+					}
+					else
+					{
+						r.first->second = player.referenceUpdate;
 					}
 				}
 			}
 		}
 	}
-	player.checkedVehicles = true;
+	boost::unordered_map<int, std::size_t>::iterator r = player.referencedVehicles.begin();
+	while (r != player.referencedVehicles.end())
+	{
+		if (r->second != player.referenceUpdate)
+		{
+			removeVehicleReference(r->first);
+			r = player.referencedVehicles.erase(r);
+		}
+		else
+		{
+			++r;
+		}
+	}
 }
 
-void Streamer::streamVehicles()
+void Streamer::addVehicleReference(Player &player, const Item::SharedVehicle &vehicle)
 {
-	// Append moving vehicles to discoveredVehicles
-	for (boost::unordered_set<Item::SharedVehicle>::iterator v = movingVehicles.begin(); v != movingVehicles.end(); ++v)
+	if (++core->getData()->vehicleReferences[vehicle->vehicleID] == 1)
 	{
-		boost::unordered_map<int, Item::SharedVehicle>::iterator d = core->getData()->discoveredVehicles.find((*v)->vehicleID);
-		if (d == core->getData()->discoveredVehicles.end())
+		if (core->getData()->internalVehicles.find(vehicle->vehicleID) == core->getData()->internalVehicles.end())
 		{
-			//sampgdk_logprintf("STREAMERDEBUG: append moving vehicle internal PRE: %d", (*v)->vehicleID);
-			boost::unordered_map<int, Item::SharedVehicle>::iterator x = core->getData()->vehicles.find((*v)->vehicleID);
-			if (x != core->getData()->vehicles.end())
-			{
-				core->getData()->discoveredVehicles.insert((*x));
-				//sampgdk_logprintf("STREAMERDEBUG: append moving vehicle internal: %d", (*v)->vehicleID);
-			}
+			vehicle->worldID = !vehicle->worlds.empty() ? player.worldID : 0;
+			core->getData()->discoveredVehicles.insert(std::make_pair(vehicle->vehicleID, vehicle));
+		}
+	}
+}
+
+void Streamer::removeVehicleReference(int vehicleID)
+{
+	boost::unordered_map<int, std::size_t>::iterator r = core->getData()->vehicleReferences.find(vehicleID);
+	if (r != core->getData()->vehicleReferences.end())
+	{
+		if (!--r->second)
+		{
+			core->getData()->vehicleReferences.quick_erase(r);
+			core->getData()->discoveredVehicles.erase(vehicleID);
+			core->getData()->releasedVehicles.push_back(vehicleID);
 		}
 	}
-	boost::unordered_map<int, int>::iterator i = core->getData()->internalVehicles.begin();
-	while (i != core->getData()->internalVehicles.end())
+}
+
+void Streamer::releaseVehicleReferences(Player &player)
+{
+	for (boost::unordered_map<int, std::size_t>::const_iterator r = player.referencedVehicles.begin(); r != player.referencedVehicles.end(); ++r)
 	{
-		boost::unordered_map<int, Item::SharedVehicle>::iterator d = core->getData()->discoveredVehicles.find(i->first);
-		if (d == core->getData()->discoveredVehicles.end())
+		removeVehicleReference(r->first);
+	}
+	player.referencedVehicles.clear();
+}
+
+void Streamer::streamVehicles()
+{
+	std::vector<int> releasedVehicles;
+	std::swap(core->getData()->releasedVehicles, releasedVehicles);
+	for (std::vector<int>::const_iterator r = releasedVehicles.begin(); r != releasedVehicles.end(); ++r)
+	{
+		if (core->getData()->vehicleReferences.find(*r) == core->getData()->vehicleReferences.end())
 		{
-			//sampgdk_logprintf("STREAMERDEBUG: d == discoveredVehicles.end() internal: %d, streamer: %d", i->first, i->second);
-			boost::unordered_map<int, Item::SharedVehicle>::iterator v = core->getData()->vehicles.find(i->second);
-			if (v != core->getData()->vehicles.end())
+			boost::unordered_map<int, int>::iterator i = core->getData()->internalVehicles.find(*r);
+			if (i != core->getData()->internalVehicles.end())
 			{
-				sampgdk::GetVehiclePos(i->second, &v->second->position[0], &v->second->position[1], &v->second->position[2]);
-				sampgdk::GetVehicleRotationQuat(i->second, &v->second->quat[0], &v->second->quat[1], &v->second->quat[2], &v->second->quat[3]);
-				sampgdk::GetVehicleZAngle(i->second, &v->second->angle);
-				sampgdk::GetVehicleHealth(i->second, &v->second->health);
-				if (v->second->streamCallbacks)
+				boost::unordered_map<int, Item::SharedVehicle>::iterator v = core->getData()->vehicles.find(i->first);
+				if (v != core->getData()->vehicles.end())
 				{
-					streamOutCallbacks.push_back(boost::make_tuple(STREAMER_TYPE_VEHICLE, v->first));
+					if (movingVehicles.find(v->second) != movingVehicles.end())
+					{
+						core->getData()->releasedVehicles.push_back(*r);
+						continue;
+					}
+					sampgdk::GetVehiclePos(i->second, &v->second->position[0], &v->second->position[1], &v->second->position[2]);
+					sampgdk::GetVehicleRotationQuat(i->second, &v->second->quat[0], &v->second->quat[1], &v->second->quat[2], &v->second->quat[3]);
+					sampgdk::GetVehicleZAngle(i->second, &v->second->angle);
+					sampgdk::GetVehicleHealth(i->second, &v->second->health);
+					if (v->second->streamCallbacks)
+					{
+						streamOutCallbacks.push_back(boost::make_tuple(STREAMER_TYPE_VEHICLE, v->first));
+					}
 				}
+				sampgdk::DestroyVehicle(i->second);
+				core->getData()->reverseVehicles.erase(i->second);
+				core->getData()->internalVehicles.quick_erase(i);
 			}
-			sampgdk::DestroyVehicle(i->second);
-			i = core->getData()->internalVehicles.erase(i);
-		}
-		else
-		{
-			////sampgdk_logprintf("STREAMERDEBUG: discoveredVehicles.erase(d) %d", d->second->vehicleID);
-			core->getData()->discoveredVehicles.erase(d);
-			++i;
 		}
 	}
+	if (core->getData()->discoveredVehicles.empty() || core->getData()->internalVehicles.size() >= core->getData()->getGlobalMaxVisibleItems(STREAMER_TYPE_VEHICLE))
+	{
+		return;
+	}
 	std::multimap<int, Item::SharedVehicle> sortedVehicles;
 	for (boost::unordered_map<int, Item::SharedVehicle>::iterator d = core->getData()->discoveredVehicles.begin(); d != core->getData()->discoveredVehicles.end(); ++d)
 	{
 		sortedVehicles.insert(std::make_pair(d->second->priority, d->second));
 	}
-	core->getData()->discoveredVehicles.clear();
 
 	for (std::multimap<int, Item::SharedVehicle>::iterator i = sortedVehicles.begin(); i != sortedVehicles.end(); ++i)
 	{
@@ -1731,21 +2243,23 @@ void Streamer::streamVehicles()
 			streamInCallbacks.push_back(boost::make_tuple(STREAMER_TYPE_VEHICLE, i->second->vehicleID));
 		}
 		core->getData()->internalVehicles.insert(std::make_pair(i->second->vehicleID, internalID));
-	}
-	for (boost::unordered_map<int, Player>::iterator p = core->getData()->players.begin(); p != core->getData()->players.end(); ++p)
-	{
-		p->second.checkedVehicles = false;
+		core->getData()->reverseVehicles.insert(internalID, i->second->vehicleID);
+		core->getData()->discoveredVehicles.erase(i->second->vehicleID);
 	}
 }
 
 void Streamer::processActiveItems()
 {
-	if (!movingObjects.empty())
+	if (!objectMoves.empty())
 	{
+		objectMoveTime = boost::chrono::steady_clock::now();
 		processMovingObjects();
 	}
-	processVehicles();
-	if (!movingVehicles.empty())
+	if (!vehicleRespawns.empty())
+	{
+		processVehicleRespawns();
+	}
+	if (!movingVehicles.empty() || !core->getData()->drivenVehicles.empty())
 	{
 		processMovingVehicles();
 	}
@@ -1765,44 +2279,77 @@ void Streamer::processActiveItems()
 
 void Streamer::processMovingObjects()
 {
-	boost::unordered_set<Item::SharedObject>::iterator o = movingObjects.begin();
-	while (o != movingObjects.end())
+	std::vector<std::pair<boost::chrono::steady_clock::time_point, int> > dueObjectMoves;
+	while (!objectMoves.empty() && objectMoves.top().first <= objectMoveTime)
 	{
-		bool objectFinishedMoving = false;
-		if ((*o)->move)
+		dueObjectMoves.push_back(objectMoves.top());
+		objectMoves.pop();
+	}
+	for (std::vector<std::pair<boost::chrono::steady_clock::time_point, int> >::iterator d = dueObjectMoves.begin(); d != dueObjectMoves.end(); ++d)
+	{
+		boost::unordered_map<int, Item::SharedObject>::iterator o = core->getData()->objects.find(d->second);
+		if (o == core->getData()->objects.end() || !o->second->move || o->second->move->deadline != d->first)
 		{
-			boost::chrono::duration<float, boost::milli> elapsedTime = boost::chrono::steady_clock::now() - (*o)->move->time;
-			if (elapsedTime.count() < (*o)->move->duration)
-			{
-				(*o)->position = (*o)->move->position.get<1>() + ((*o)->move->position.get<2>() * elapsedTime.count());
-				if (!Utility::almostEquals((*o)->move->rotation.get<0>().maxCoeff(), -1000.0f))
-				{
-					(*o)->rotation = (*o)->move->rotation.get<1>() + ((*o)->move->rotation.get<2>() * elapsedTime.count());
-				}
-			}
-			else
-			{
-				(*o)->position = (*o)->move->position.get<0>();
-				if (!Utility::almostEquals((*o)->move->rotation.get<0>().maxCoeff(), -1000.0f))
-				{
-					(*o)->rotation = (*o)->move->rotation.get<0>();
-				}
-				(*o)->move.reset();
-				objectMoveCallbacks.push_back((*o)->objectID);
-				objectFinishedMoving = true;
-			}
-			if ((*o)->cell)
-			{
-				core->getGrid()->removeObject(*o, true);
-			}
+			continue;
 		}
-		if (objectFinishedMoving)
+		updateObjectMove(o->second, objectMoveTime);
+		if (objectMoveTime >= o->second->move->time + boost::chrono::milliseconds(o->second->move->duration))
 		{
-			o = movingObjects.erase(o);
+			o->second->move.reset();
+			objectMoveCallbacks.push_back(o->first);
 		}
-		else
+		if (o->second->move)
+		{
+			o->second->move->deadline = boost::chrono::steady_clock::time_point();
+		}
+		if (o->second->cell)
+		{
+			core->getGrid()->removeObject(o->second, true);
+		}
+		if (o->second->move && o->second->move->deadline == boost::chrono::steady_clock::time_point())
+		{
+			scheduleObjectMove(o->second);
+		}
+	}
+}
+
+void Streamer::scheduleObjectMove(const Item::SharedObject &object)
+{
+	object->move->deadline = object->move->time + boost::chrono::milliseconds(object->move->duration);
+	if (object->cell)
+	{
+		Eigen::Vector2f position(object->move->position.get<1>()[0], object->move->position.get<1>()[1]), velocity(object->move->position.get<2>()[0], object->move->position.get<2>()[1]);
+		float exitTime = core->getGrid()->getCellExitTime(object->cell, position, velocity);
+		if (exitTime < static_cast<float>(object->move->duration))
+		{
+			object->move->deadline = object->move->time + boost::chrono::duration_cast<boost::chrono::steady_clock::duration>(boost::chrono::duration<float, boost::milli>(exitTime));
+		}
+	}
+	if (object->move->deadline <= objectMoveTime)
+	{
+		object->move->deadline = objectMoveTime + boost::chrono::steady_clock::duration(1);
+	}
+	objectMoves.push(std::make_pair(object->move->deadline, object->objectID));
+}
+
+void Streamer::updateObjectMove(const Item::SharedObject &object, boost::chrono::steady_clock::time_point time)
+{
+	if (time < object->move->time + boost::chrono::milliseconds(object->move->duration))
+	{
+		boost::chrono::duration<float, boost::milli> elapsedTime = time - object->move->time;
+		float elapsed = std::max(elapsedTime.count(), 0.0f);
+		object->position = object->move->position.get<1>() + (object->move->position.get<2>() * elapsed);
+		if (!Utility::almostEquals(object->move->rotation.get<0>().maxCoeff(), -1000.0f))
 		{
-			++o;
+			object->rotation = object->move->rotation.get<1>() + (object->move->rotation.get<2>() * elapsed);
+		}
+	}
+	else
+	{
+		object->position = object->move->position.get<0>();
+		if (!Utility::almostEquals(object->move->rotation.get<0>().maxCoeff(), -1000.0f))
+		{
+			object->rotation = object->move->rotation.get<0>();
 		}
 	}
 }
@@ -1839,6 +2386,10 @@ void Streamer::processAttachedAreas()
 						boost::unordered_map<int, Item::SharedObject>::iterator o = core->getData()->objects.find((*a)->attach->object.get<0>());
 						if (o != core->getData()->objects.end())
 						{
+							if (o->second->move)
+							{
+								updateObjectMove(o->second, objectMoveTime);
+							}
 							Utility::constructAttachedArea(*a, boost::variant<float, Eigen::Vector3f, Eigen::Vector4f>(o->second->rotation), o->second->position);
 							adjust = true;
 						}
@@ -1861,17 +2412,7 @@ void Streamer::processAttachedAreas()
 				if ((*a)->attach->vehicleType == STREAMER_VEHICLE_TYPE_STATIC)
 				{
 					adjust = sampgdk::GetVehiclePos((*a)->attach->vehicle, &position[0], &position[1], &position[2]);
-					for (boost::unordered_map<int, Player>::iterator p = core->getData()->players.begin(); p != core->getData()->players.end(); ++p)
-					{
-						if (sampgdk::GetPlayerState(p->first) == PLAYER_STATE_DRIVER)
-						{
-							if (sampgdk::GetPlayerVehicleID(p->first) == (*a)->attach->vehicle)
-							{
-								occupied = true;
-								break;
-							}
-						}
-					}
+					occupied = Utility::isVehicleOccupied((*a)->attach->vehicle);
 				}
 				else
 				{
@@ -1882,17 +2423,7 @@ void Streamer::processAttachedAreas()
 						if (i != core->getData()->internalVehicles.end())
 						{
 							adjust = sampgdk::GetVehiclePos(i->second, &position[0], &position[1], &position[2]);
-							for (boost::unordered_map<int, Player>::iterator p = core->getData()->players.begin(); p != core->getData()->players.end(); ++p)
-							{
-								if (sampgdk::GetPlayerState(p->first) == PLAYER_STATE_DRIVER)
-								{
-									if (sampgdk::GetPlayerVehicleID(p->first) == (*a)->attach->vehicle)
-									{
-										occupied = true;
-										break;
-									}
-								}
-							}
+							occupied = Utility::isVehicleOccupied(i->second);
 						}
 						else
 						{
@@ -1918,10 +2449,7 @@ void Streamer::processAttachedAreas()
 			}
 			if (adjust)
 			{
-				if ((*a)->cell)
-				{
-					core->getGrid()->removeArea(*a, true);
-				}
+				core->getGrid()->removeArea(*a, true);
 			}
 			else
 			{
@@ -1973,6 +2501,10 @@ void Streamer::processAttachedObjects()
 				boost::unordered_map<int, Item::SharedObject>::iterator p = core->getData()->objects.find((*o)->attach->object);
 				if (p != core->getData()->objects.end())
 				{
+					if (p->second->move)
+					{
+						updateObjectMove(p->second, objectMoveTime);
+					}
 					(*o)->attach->position = p->second->position;
 					adjust = true;
 				}
@@ -2070,195 +2602,160 @@ void Streamer::processAttachedTextLabels()
 	}
 }
 
-void Streamer::processVehicles()
+void Streamer::processVehicleRespawns()
 {
-	for (boost::unordered_map<int, Item::SharedVehicle>::iterator v = core->getData()->vehicles.begin(); v != core->getData()->vehicles.end(); ++v)
+	boost::chrono::steady_clock::time_point now = boost::chrono::steady_clock::now();
+	while (!vehicleRespawns.empty() && vehicleRespawns.top().first <= now)
 	{
-		if (v->second->touched)
+		boost::unordered_map<int, Item::SharedVehicle>::iterator v = core->getData()->vehicles.find(vehicleRespawns.top().second);
+		vehicleRespawns.pop();
+		if (v == core->getData()->vehicles.end())
+		{
+			continue;
+		}
+		v->second->respawnScheduled = false;
+		if (!v->second->touched || v->second->respawnDelay == -1)
+		{
+			continue;
+		}
+		if (getVehicleRespawnTime(v->second) > now)
+		{
+			scheduleVehicleRespawn(v->second);
+			continue;
+		}
+		v->second->position = v->second->spawn.position;
+		v->second->angle = v->second->spawn.angle;
+		v->second->color = v->second->spawn.color;
+		v->second->paintjob = 3; 
+		v->second->health = 1000.0f;
+		v->second->carmods.clear();
+		v->second->touched = false;
+		v->second->used = false;
+		v->second->spawnedTime = boost::chrono::steady_clock::now();
+		v->second->lastUpdatedTime = boost::chrono::steady_clock::now();
+		v->second->panels = 0;
+		v->second->doors = 0;
+		v->second->lights = 0;
+		v->second->tires = 0;
+		v->second->params.engine = VEHICLE_PARAMS_UNSET;
+		v->second->params.lights = VEHICLE_PARAMS_UNSET;
+		v->second->params.alarm = VEHICLE_PARAMS_UNSET;
+		v->second->params.doors = VEHICLE_PARAMS_UNSET;
+		v->second->params.bonnet = VEHICLE_PARAMS_UNSET;
+		v->second->params.boot = VEHICLE_PARAMS_UNSET;
+		v->second->params.objective = VEHICLE_PARAMS_UNSET;
+		v->second->params.siren = VEHICLE_PARAMS_UNSET;
+		v->second->params.cardoors.driver = VEHICLE_PARAMS_UNSET;
+		v->second->params.cardoors.passenger = VEHICLE_PARAMS_UNSET;
+		v->second->params.cardoors.backleft = VEHICLE_PARAMS_UNSET;
+		v->second->params.cardoors.backright = VEHICLE_PARAMS_UNSET;
+		v->second->params.carwindows.driver = VEHICLE_PARAMS_UNSET;
+		v->second->params.carwindows.passenger = VEHICLE_PARAMS_UNSET;
+		v->second->params.carwindows.backleft = VEHICLE_PARAMS_UNSET;
+		v->second->params.carwindows.backright = VEHICLE_PARAMS_UNSET;
+		if (v->second->cell)
+		{
+			core->getGrid()->removeVehicle(v->second, true);
+		}
+		boost::unordered_map<int, int>::iterator i = core->getData()->internalVehicles.find(v->second->vehicleID);
+		if (i != core->getData()->internalVehicles.end())
 		{
-			bool occupied = false;
-			for (boost::unordered_map<int, Player>::iterator p = core->getData()->players.begin(); p != core->getData()->players.end(); ++p)
+			sampgdk::DestroyVehicle(i->second);
+			core->getData()->reverseVehicles.erase(i->second);
+			int internalID = INVALID_VEHICLE_ID;
+			switch (v->second->modelID)
 			{
-				if (sampgdk::GetPlayerState(p->first) == PLAYER_STATE_DRIVER)
+				case 537:
+				case 538:
 				{
-					boost::unordered_map<int, int>::iterator i = core->getData()->internalVehicles.find(v->second->vehicleID);
-					if (i != core->getData()->internalVehicles.end())
-					{
-						if (sampgdk::GetPlayerVehicleID(p->first) == i->second)
-						{
-							occupied = true;
-							//sampgdk_logprintf("STREAMERDEBUG: found occupied vehicle %d", v->second->vehicleID);
-							break;
-						}
-					}
+					//internalID = AddStaticVehicle(v->second->modelID, v->second->position[0], v->second->position[1], v->second->position[2], v->second->angle, v->second->color1, v->second->color2);
+					// TODO - This won't work properly without modifing train handling in samp server
+					// If you create train, then you create 4 vehicle - the base model ID has been returned, but the last 3 trailer not and you can't get these IDs - only when these ids are in sequence
+					// but these IDs won't be in sequence when server randomly destroy and create vehicles at different ids - for more info: http://pastebin.com/wZsiVHBr
+					break;
 				}
-			}
-			// Make sure that vehicle isn't in 'movingVehicles' container when it isn't active
-			if (occupied)
-			{
-				boost::unordered_set<Item::SharedVehicle>::iterator m = movingVehicles.find(v->second);
-				if (m == movingVehicles.end())
+				default:
 				{
-					movingVehicles.insert(v->second);
-					//sampgdk_logprintf("STREAMERDEBUG: inserting unoccupied vehicle %d", v->second->vehicleID);
+					internalID = sampgdk::CreateVehicle(v->second->modelID, v->second->position[0], v->second->position[1], v->second->position[2], v->second->angle, v->second->color[0], v->second->color[1], -1, v->second->spawn.addsiren);
+					break;
 				}
 			}
-			else
+			if (internalID == INVALID_VEHICLE_ID)
 			{
-				if (v->second->used) // 
-				{
-					boost::unordered_set<Item::SharedVehicle>::iterator m = movingVehicles.find(v->second);
-					if (m != movingVehicles.end())
-					{
-						movingVehicles.erase(m);
-						//sampgdk_logprintf("STREAMERDEBUG: removing unoccupied vehicle from moving list %d", v->second->vehicleID);
-					}
-				}
+				core->getData()->internalVehicles.erase(i);
+				movingVehicles.erase(v->second);
+				continue;
 			}
-
-			// Custom vehicle respawn
-			if (v->second->respawnDelay != -1)
+			if (!v->second->numberplate.empty())
 			{
-				boost::chrono::duration<float, boost::milli> elapsedTimeSinceSpawn = boost::chrono::steady_clock::now() - v->second->spawnedTime;
-				boost::chrono::duration<float, boost::milli> elapsedTimeSinceLastUpdate = boost::chrono::steady_clock::now() - v->second->lastUpdatedTime;
-
-				bool respawnVehicle = false;
-				if (/*core->getStreamer()->defaultVehicleRespawn*/ true)
-				{
-					if (elapsedTimeSinceSpawn.count() > 10000)
-					{
-						respawnVehicle = true;
-					}
-				}
-				else
+				sampgdk::SetVehicleNumberPlate(internalID, v->second->numberplate.c_str());
+			}
+			if (v->second->interior)
+			{
+				sampgdk::LinkVehicleToInterior(internalID, v->second->interior);
+			}
+			if (v->second->worldID)
+			{
+				sampgdk::SetVehicleVirtualWorld(internalID, v->second->worldID);
+			}
+			if (!v->second->carmods.empty())
+			{
+				for (std::vector<int>::iterator c = v->second->carmods.begin(); c != v->second->carmods.end(); ++c)
 				{
-					// Do not check for respawn in first 10 second after spawned, and respawn only if vehicle has been used
-					if (elapsedTimeSinceSpawn.count() > 10000 && v->second->used)
-					{
-						respawnVehicle = true;
-					}
-				}
-
-				if (respawnVehicle)
-				{
-					// If respawnDelay time passed since last update, then respawn
-					if (elapsedTimeSinceLastUpdate.count() >= v->second->respawnDelay)
-					{
-						v->second->position = v->second->spawn.position;
-						v->second->angle = v->second->spawn.angle;
-						v->second->color = v->second->spawn.color;
-						v->second->paintjob = 3; 
-						v->second->health = 1000.0f;
-						v->second->carmods.clear();
-						v->second->touched = false;
-						v->second->used = false;
-						v->second->spawnedTime = boost::chrono::steady_clock::now();
-						v->second->lastUpdatedTime = boost::chrono::steady_clock::now();
-						v->second->panels = 0;
-						v->second->doors = 0;
-						v->second->lights = 0;
-						v->second->tires = 0;
-						v->second->params.engine = VEHICLE_PARAMS_UNSET;
-						v->second->params.lights = VEHICLE_PARAMS_UNSET;
-						v->second->params.alarm = VEHICLE_PARAMS_UNSET;
-						v->second->params.doors = VEHICLE_PARAMS_UNSET;
-						v->second->params.bonnet = VEHICLE_PARAMS_UNSET;
-						v->second->params.boot = VEHICLE_PARAMS_UNSET;
-						v->second->params.objective = VEHICLE_PARAMS_UNSET;
-						v->second->params.siren = VEHICLE_PARAMS_UNSET;
-						v->second->params.cardoors.driver = VEHICLE_PARAMS_UNSET;
-						v->second->params.cardoors.passenger = VEHICLE_PARAMS_UNSET;
-						v->second->params.cardoors.backleft = VEHICLE_PARAMS_UNSET;
-						v->second->params.cardoors.backright = VEHICLE_PARAMS_UNSET;
-						v->second->params.carwindows.driver = VEHICLE_PARAMS_UNSET;
-						v->second->params.carwindows.passenger = VEHICLE_PARAMS_UNSET;
-						v->second->params.carwindows.backleft = VEHICLE_PARAMS_UNSET;
-						v->second->params.carwindows.backright = VEHICLE_PARAMS_UNSET;
-						if (v->second->cell)
-						{
-							core->getGrid()->removeVehicle(v->second, true);
-						}
-						boost::unordered_map<int, int>::iterator i = core->getData()->internalVehicles.find(v->second->vehicleID);
-						if (i != core->getData()->internalVehicles.end())
-						{
-							sampgdk::DestroyVehicle(i->second);
-							int internalID = INVALID_VEHICLE_ID;
-							switch (v->second->modelID)
-							{
-								case 537:
-								case 538:
-								{
-									//internalID = AddStaticVehicle(v->second->modelID, v->second->position[0], v->second->position[1], v->second->position[2], v->second->angle, v->second->color1, v->second->color2);
-									// TODO - This won't work properly without modifing train handling in samp server
-									// If you create train, then you create 4 vehicle - the base model ID has been returned, but the last 3 trailer not and you can't get these IDs - only when these ids are in sequence
-									// but these IDs won't be in sequence when server randomly destroy and create vehicles at different ids - for more info: http://pastebin.com/wZsiVHBr
-									break;
-								}
-								default:
-								{
-									internalID = sampgdk::CreateVehicle(v->second->modelID, v->second->position[0], v->second->position[1], v->second->position[2], v->second->angle, v->second->color[0], v->second->color[1], -1, v->second->spawn.addsiren);
-									break;
-								}
-							}
-							if (internalID == INVALID_VEHICLE_ID)
-							{
-								break;
-							}
-							if (!v->second->numberplate.empty())
-							{
-								sampgdk::SetVehicleNumberPlate(internalID, v->second->numberplate.c_str());
-							}
-							if (v->second->interior)
-							{
-								sampgdk::LinkVehicleToInterior(internalID, v->second->interior);
-							}
-							if (v->second->worldID)
-							{
-								sampgdk::SetVehicleVirtualWorld(internalID, v->second->worldID);
-							}
-							if (!v->second->carmods.empty())
-							{
-								for (std::vector<int>::iterator c = v->second->carmods.begin(); c != v->second->carmods.end(); ++c)
-								{
-									sampgdk::AddVehicleComponent(internalID, *c);
-								}
-							}
-							if (v->second->paintjob != 3)
-							{
-								sampgdk::ChangeVehiclePaintjob(internalID, v->second->paintjob);
-							}
-							if (v->second->streamCallbacks)
-							{
-								streamInCallbacks.push_back(boost::make_tuple(STREAMER_TYPE_VEHICLE, v->second->vehicleID));
-							}
-							i->second = internalID;
-						}
-						for (std::set<AMX*>::iterator a = core->getData()->interfaces.begin(); a != core->getData()->interfaces.end(); ++a)
-						{
-							int amxIndex = 0;
-							if (!amx_FindPublic(*a, "OnDynamicVehicleSpawn", &amxIndex))
-							{
-								amx_Push(*a, static_cast<cell>(v->second->vehicleID));
-								amx_Exec(*a, NULL, amxIndex);
-							}
-						}
-						//sampgdk_logprintf("STREAMERDEBUG: respawn occupied: %d", v->second->vehicleID);
-						movingVehicles.erase(v->second);
-						//continue; CHECK IT
-					}
+					sampgdk::AddVehicleComponent(internalID, *c);
 				}
 			}
+			if (v->second->paintjob != 3)
+			{
+				sampgdk::ChangeVehiclePaintjob(internalID, v->second->paintjob);
+			}
+			if (v->second->streamCallbacks)
+			{
+				streamInCallbacks.push_back(boost::make_tuple(STREAMER_TYPE_VEHICLE, v->second->vehicleID));
+			}
+			i->second = internalID;
+			core->getData()->reverseVehicles.insert(internalID, v->second->vehicleID);
+		}
+		for (std::set<AMX*>::iterator a = core->getData()->interfaces.begin(); a != core->getData()->interfaces.end(); ++a)
+		{
+			int amxIndex = 0;
+			if (Utility::findPublic(*a, STREAMER_CALLBACK_ON_DYNAMIC_VEHICLE_SPAWN, amxIndex))
+			{
+				amx_Push(*a, static_cast<cell>(v->second->vehicleID));
+				amx_Exec(*a, NULL, amxIndex);
+			}
 		}
+		//sampgdk_logprintf("STREAMERDEBUG: respawn occupied: %d", v->second->vehicleID);
+		movingVehicles.erase(v->second);
+	}
+}
+
+void Streamer::scheduleVehicleRespawn(const Item::SharedVehicle &vehicle)
+{
+	if (vehicle->respawnDelay != -1 && !vehicle->respawnScheduled)
+	{
+		vehicleRespawns.push(std::make_pair(getVehicleRespawnTime(vehicle), vehicle->vehicleID));
+		vehicle->respawnScheduled = true;
 	}
 }
 
+boost::chrono::steady_clock::time_point Streamer::getVehicleRespawnTime(const Item::SharedVehicle &vehicle)
+{
+	return std::max(vehicle->spawnedTime + boost::chrono::milliseconds(10000), vehicle->lastUpdatedTime + boost::chrono::milliseconds(vehicle->respawnDelay));
+}
+
 void Streamer::processMovingVehicles()
 {
-	//boost::unordered_set<Item::SharedVehicle>::iterator v = movingVehicles.begin();
-	for(boost::unordered_set<Item::SharedVehicle>::iterator v = movingVehicles.begin(); v != movingVehicles.end(); ++v)
+	boost::unordered_set<Item::SharedVehicle>::iterator v = movingVehicles.begin();
+	while (v != movingVehicles.end())
 	{
 		bool adjust = false;
 		boost::unordered_map<int, int>::iterator i = core->getData()->internalVehicles.find((*v)->vehicleID);
+		if (i == core->getData()->internalVehicles.end() || !Utility::isVehicleOccupied(i->second))
+		{
+			v = movingVehicles.erase(v);
+			continue;
+		}
 		if (i != core->getData()->internalVehicles.end())
 		{
 			if ((*v)->vehicleID)
@@ -2283,6 +2780,19 @@ void Streamer::processMovingVehicles()
 				(*v)->position.fill(std::numeric_limits<float>::infinity());
 			}
 		}
-//		++v;
+		++v;
+	}
+	if (!core->getData()->drivenVehicles.empty())
+	{
+		std::vector<int> drivenVehicles;
+		std::swap(core->getData()->drivenVehicles, drivenVehicles);
+		for (std::vector<int>::const_iterator d = drivenVehicles.begin(); d != drivenVehicles.end(); ++d)
+		{
+			boost::unordered_map<int, Item::SharedVehicle>::iterator w = core->getData()->vehicles.find(core->getData()->reverseVehicles.find(*d));
+			if (w != core->getData()->vehicles.end())
+			{
+				movingVehicles.insert(w->second);
+			}
+		}
 	}
 }
\ No newline at end of file
@@ -24,10 +24,16 @@
 #include "utility.h"
 
 #include <boost/tuple/tuple.hpp>
+#include <boost/unordered_map.hpp>
 #include <boost/unordered_set.hpp>
 
+#include <algorithm>
 #include <bitset>
+#include <cmath>
+#include <functional>
 #include <map>
+#include <queue>
+#include <vector>
 
 class Streamer
 {
@@ -54,60 +60,104 @@ public:
 		return false;
 	}
 
+	inline std::size_t getTickBudget()
+	{
+		return tickBudget;
+	}
+
+	inline void setTickBudget(std::size_t value)
+	{
+		tickBudget = value;
+	}
+
+	inline std::size_t getPendingPlayerUpdates()
+	{
+		return pendingPlayerUpdates;
+	}
+
 	std::size_t getChunkSize(int type);
 	bool setChunkSize(int type, std::size_t value);
 
 	void startAutomaticUpdate();
 	void startManualUpdate(Player &player, int type);
 
+	void releasePlayerReferences(Player &player);
+	void scheduleObjectMove(const Item::SharedObject &object);
+	void scheduleVehicleRespawn(const Item::SharedVehicle &vehicle);
+	void updateObjectMove(const Item::SharedObject &object, boost::chrono::steady_clock::time_point time);
+
 	void processActiveItems();
 
 	boost::unordered_set<Item::SharedArea> attachedAreas;
 	boost::unordered_set<Item::SharedObject> attachedObjects;
 	boost::unordered_set<Item::SharedTextLabel> attachedTextLabels;
-	boost::unordered_set<Item::SharedObject> movingObjects;
 	boost::unordered_set<Item::SharedVehicle> movingVehicles;
 private:
 	void calculateAverageElapsedTime();
 
 	void performPlayerChunkUpdate(Player &player, bool automatic);
 	void performPlayerUpdate(Player &player, bool automatic);
+	bool updatePlayerState(Player &player, Eigen::Vector3f &delta);
+	void discoverPlayerItems(Player &player, bool update, bool automatic, const Eigen::Vector3f &delta);
 	void executeCallbacks();
 
+	void validateCachedCells(Player &player);
+
 	void discoverActors(Player &player, const std::vector<SharedCell> &cells);
+	void addActorReference(Player &player, const Item::SharedActor &actor);
+	void removeActorReference(int actorID);
+	void releaseActorReferences(Player &player);
 	void streamActors();
 
-	void processAreas(Player &player, const std::vector<SharedCell> &cells);
+	void processAreas(Player &player);
 	void processCheckpoints(Player &player, const std::vector<SharedCell> &cells);
 	void processRaceCheckpoints(Player &player, const std::vector<SharedCell> &cells);
 
 	void discoverMapIcons(Player &player, const std::vector<SharedCell> &cells);
+	void discoverMapIcon(Player &player, const Item::SharedMapIcon &mapIcon, bool satisfied);
+	void discoverMapIconAtDistance(Player &player, const Item::SharedMapIcon &mapIcon, float distance);
 	void streamMapIcons(Player &player, bool automatic);
 
 	void discoverObjects(Player &player, const std::vector<SharedCell> &cells);
+	void discoverObject(Player &player, const Item::SharedObject &object, bool satisfied);
+	void discoverObjectAtDistance(Player &player, const Item::SharedObject &object, float distance);
+	std::size_t estimateObjectBytes(const Item::SharedObject &object);
 	void streamObjects(Player &player, bool automatic);
 
 	void discoverPickups(Player &player, const std::vector<SharedCell> &cells);
+	void addPickupReference(Player &player, const Item::SharedPickup &pickup);
+	void removePickupReference(int pickupID);
+	void releasePickupReferences(Player &player);
 	void streamPickups();
 
 	void discoverTextLabels(Player &player, const std::vector<SharedCell> &cells);
+	void discoverTextLabel(Player &player, const Item::SharedTextLabel &textLabel, bool satisfied);
+	void discoverTextLabelAtDistance(Player &player, const Item::SharedTextLabel &textLabel, float distance);
+	std::size_t estimateTextLabelBytes(const Item::SharedTextLabel &textLabel);
 	void streamTextLabels(Player &player, bool automatic);
 
 	void discoverVehicles(Player &player, const std::vector<SharedCell> &cells);
+	void addVehicleReference(Player &player, const Item::SharedVehicle &vehicle);
+	void removeVehicleReference(int vehicleID);
+	void releaseVehicleReferences(Player &player);
 	void streamVehicles();
 
 	void processMovingObjects();
 	void processAttachedAreas();
 	void processAttachedObjects();
 	void processAttachedTextLabels();
-	void processVehicles();
+	void processVehicleRespawns();
+	boost::chrono::steady_clock::time_point getVehicleRespawnTime(const Item::SharedVehicle &vehicle);
 	void processMovingVehicles();
 
 	std::size_t chunkSize[STREAMER_MAX_TYPES];
 
+	std::size_t tickBudget;
 	std::size_t tickCount;
 	std::size_t tickRate;
 
+	std::size_t pendingPlayerUpdates;
+
 	float averageElapsedTime;
 	float lastUpdateTime;
 
@@ -118,9 +168,209 @@ private:
 
 	std::vector<int> objectMoveCallbacks;
 
+	boost::chrono::steady_clock::time_point objectMoveTime;
+	std::priority_queue<std::pair<boost::chrono::steady_clock::time_point, int>, std::vector<std::pair<boost::chrono::steady_clock::time_point, int> >, std::greater<std::pair<boost::chrono::steady_clock::time_point, int> > > objectMoves;
+
 	std::vector<boost::tuple<int, int> > streamInCallbacks;
 	std::vector<boost::tuple<int, int> > streamOutCallbacks;
 
+	std::priority_queue<std::pair<boost::chrono::steady_clock::time_point, int>, std::vector<std::pair<boost::chrono::steady_clock::time_point, int> >, std::greater<std::pair<boost::chrono::steady_clock::time_point, int> > > vehicleRespawns;
+
+	std::size_t filteredCellUpdate;
+	boost::unordered_map<std::pair<Cell*, std::pair<int, int> >, FilteredCell<Item::SharedMapIcon> > filteredMapIconCells;
+	boost::unordered_map<std::pair<Cell*, std::pair<int, int> >, FilteredCell<Item::SharedObject> > filteredObjectCells;
+	boost::unordered_map<std::pair<Cell*, std::pair<int, int> >, FilteredCell<Item::SharedTextLabel> > filteredTextLabelCells;
+
+	template<typename T>
+	inline CachedCell<T> *findCachedCell(Player &player, boost::unordered_map<Cell*, CachedCell<T> > &cachedCells, const SharedCell &cell)
+	{
+		if (!cell->version)
+		{
+			return NULL;
+		}
+		CachedCell<T> &cachedCell = cachedCells[cell.get()];
+		if (!cachedCell.cell)
+		{
+			cachedCell.cell = cell;
+		}
+		cachedCell.update = player.cachedCellUpdate;
+		return &cachedCell;
+	}
+
+	inline bool isWithinChunkByteBudget(const Player &player, int type, std::size_t chunkBytes, std::size_t itemBytes)
+	{
+		return !player.chunkByteBudget[type] || !chunkBytes || chunkBytes + itemBytes <= player.chunkByteBudget[type];
+	}
+
+	inline bool isSwapCandidate(const std::pair<int, float> &existingItem, const std::pair<int, float> &discoveredItem)
+	{
+		return existingItem.first < discoveredItem.first || (existingItem.second > STREAMER_STATIC_DISTANCE_CUTOFF && discoveredItem.second < existingItem.second);
+	}
+
+	template<typename T>
+	inline void clearCachedCell(CachedCell<T> &cachedCell)
+	{
+		cachedCell.items.clear();
+		cachedCell.packedItems.clear();
+		cachedCell.packedIDs.clear();
+		cachedCell.packedX.clear();
+		cachedCell.packedY.clear();
+		cachedCell.packedZ.clear();
+		cachedCell.packedStreamDistances.clear();
+		cachedCell.packedCandidates.clear();
+		cachedCell.candidateUpdate = 0;
+	}
+
+	template<typename T>
+	inline void packCachedItem(CachedCell<T> &cachedCell, const T &item, int id, const Eigen::Vector3f &position)
+	{
+		cachedCell.packedItems.push_back(item);
+		cachedCell.packedIDs.push_back(id);
+		cachedCell.packedX.push_back(position[0]);
+		cachedCell.packedY.push_back(position[1]);
+		cachedCell.packedZ.push_back(position[2]);
+		cachedCell.packedStreamDistances.push_back(item->comparableStreamDistance);
+	}
+
+	template<typename T>
+	inline void calculatePackedDistances(const Player &player, CachedCell<T> &cachedCell, float radiusMultiplier, const StreamedItems &streamedItems, RemovalQueue &removedItems)
+	{
+		std::size_t count = cachedCell.packedIDs.size();
+		cachedCell.packedDistances.resize(count);
+		if (count)
+		{
+			const float *x = &cachedCell.packedX[0], *y = &cachedCell.packedY[0], *z = &cachedCell.packedZ[0];
+			float *distances = &cachedCell.packedDistances[0];
+			float playerX = player.position[0], playerY = player.position[1], playerZ = player.position[2];
+			if (player.candidateMargin > 0.0f && cachedCell.candidateUpdate == player.candidateUpdate)
+			{
+				for (std::vector<std::size_t>::const_iterator c = cachedCell.packedCandidates.begin(); c != cachedCell.packedCandidates.end(); ++c)
+				{
+					float deltaX = x[*c] - playerX, deltaY = y[*c] - playerY, deltaZ = z[*c] - playerZ;
+					distances[*c] = (deltaX * deltaX) + (deltaY * deltaY) + (deltaZ * deltaZ);
+				}
+				return;
+			}
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				float deltaX = x[i] - playerX, deltaY = y[i] - playerY, deltaZ = z[i] - playerZ;
+				distances[i] = (deltaX * deltaX) + (deltaY * deltaY) + (deltaZ * deltaZ);
+			}
+			cachedCell.packedCandidates.clear();
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				float range = cachedCell.packedStreamDistances[i] * radiusMultiplier;
+				if (player.candidateMargin > 0.0f)
+				{
+					range = std::sqrt(range) + player.candidateMargin;
+					range *= range;
+				}
+				if (distances[i] < range)
+				{
+					cachedCell.packedCandidates.push_back(i);
+				}
+				else if (streamedItems.contains(cachedCell.packedIDs[i]))
+				{
+					removedItems.push(cachedCell.packedIDs[i]);
+				}
+			}
+		}
+		else
+		{
+			cachedCell.packedCandidates.clear();
+		}
+		cachedCell.candidateUpdate = player.candidateUpdate;
+	}
+
+	template<typename T>
+	inline void selectCandidates(std::vector<std::pair<std::pair<int, float>, T> > &discoveredItems, std::vector<std::pair<std::pair<int, float>, T> > &existingItems, std::size_t maxVisibleItems)
+	{
+		if (discoveredItems.empty())
+		{
+			existingItems.clear();
+			return;
+		}
+		if (discoveredItems.size() > maxVisibleItems)
+		{
+			std::nth_element(discoveredItems.begin(), discoveredItems.begin() + maxVisibleItems, discoveredItems.end(), Item::Compare());
+			discoveredItems.erase(discoveredItems.begin() + maxVisibleItems, discoveredItems.end());
+		}
+		std::sort(discoveredItems.rbegin(), discoveredItems.rend(), Item::Compare());
+		std::sort(existingItems.begin(), existingItems.end(), Item::Compare());
+	}
+
+	template<typename T>
+	inline void eraseStaleCachedCells(Player &player, boost::unordered_map<Cell*, CachedCell<T> > &cachedCells)
+	{
+		typename boost::unordered_map<Cell*, CachedCell<T> >::iterator c = cachedCells.begin();
+		while (c != cachedCells.end())
+		{
+			if (c->second.update != player.cachedCellUpdate)
+			{
+				c = cachedCells.erase(c);
+			}
+			else
+			{
+				++c;
+			}
+		}
+	}
+
+	template<typename T>
+	inline void filterItems(const Player &player, const boost::unordered_map<int, T> &items, FilteredCell<T> &filteredCell)
+	{
+		filteredCell.excludedIDs.clear();
+		filteredCell.items.clear();
+		for (typename boost::unordered_map<int, T>::const_iterator i = items.begin(); i != items.end(); ++i)
+		{
+			if ((i->second->interiors.empty() || i->second->interiors.find(player.interiorID) != i->second->interiors.end()) && (i->second->worlds.empty() || i->second->worlds.find(player.worldID) != i->second->worlds.end()))
+			{
+				filteredCell.items.push_back(i->second);
+			}
+			else
+			{
+				filteredCell.excludedIDs.push_back(i->first);
+			}
+		}
+	}
+
+	template<typename T>
+	inline FilteredCell<T> &filterCellItems(const Player &player, boost::unordered_map<std::pair<Cell*, std::pair<int, int> >, FilteredCell<T> > &filteredCells, const SharedCell &cell, const boost::unordered_map<int, T> &items, std::size_t conditionVersion, FilteredCell<T> &uncachedCell)
+	{
+		if (!cell->version)
+		{
+			filterItems(player, items, uncachedCell);
+			return uncachedCell;
+		}
+		FilteredCell<T> &filteredCell = filteredCells[std::make_pair(cell.get(), std::make_pair(player.worldID, player.interiorID))];
+		if (filteredCell.cell != cell || filteredCell.version != cell->version || filteredCell.conditionVersion != conditionVersion)
+		{
+			filteredCell.cell = cell;
+			filteredCell.conditionVersion = conditionVersion;
+			filteredCell.version = cell->version;
+			filterItems(player, items, filteredCell);
+		}
+		filteredCell.update = filteredCellUpdate;
+		return filteredCell;
+	}
+
+	template<typename T>
+	inline void eraseStaleFilteredCells(boost::unordered_map<std::pair<Cell*, std::pair<int, int> >, FilteredCell<T> > &filteredCells)
+	{
+		typename boost::unordered_map<std::pair<Cell*, std::pair<int, int> >, FilteredCell<T> >::iterator f = filteredCells.begin();
+		while (f != filteredCells.end())
+		{
+			if (filteredCellUpdate - f->second.update > 1)
+			{
+				f = filteredCells.erase(f);
+			}
+			else
+			{
+				++f;
+			}
+		}
+	}
+
 	template<std::size_t N, typename T>
 	inline bool doesPlayerSatisfyConditions(const std::bitset<N> &a, const T &b, const boost::unordered_set<T> &c, const T &d, const boost::unordered_set<T> &e, const T &f)
 	{
@@ -133,6 +383,12 @@ private:
 		return (a[b] && (c.empty() || c.find(d) != c.end()) && (e.empty() || e.find(f) != e.end()) && (g.empty() || i ? !Utility::isContainerWithinContainer(g, h) : Utility::isContainerWithinContainer(g, h)));
 	}
 
+	template<std::size_t N, typename T>
+	inline bool doesPlayerSatisfyConditions(const std::bitset<N> &a, const T &b, const boost::unordered_set<T> &g, const boost::unordered_set<T> &h, bool i)
+	{
+		return (a[b] && (g.empty() || i ? !Utility::isContainerWithinContainer(g, h) : Utility::isContainerWithinContainer(g, h)));
+	}
+
 	template<std::size_t N, typename T>
 	inline bool doesPlayerSatisfyConditions(const std::bitset<N> &a, const T &b, const int &c, const T &d, const boost::unordered_set<T> &e, const T &f, const boost::unordered_set<T> &g, const boost::unordered_set<T> &h, bool i)
 	{
@@ -30,6 +30,8 @@
 
 #include <Eigen/Core>
 
+#include <algorithm>
+#include <map>
 #include <set>
 #include <sstream>
 #include <string>
@@ -98,6 +100,130 @@ int Utility::checkInterfaceAndRegisterNatives(AMX *amx, AMX_NATIVE_INFO *amxNati
 	return amxRegisterResult;
 }
 
+void Utility::cacheInterface(AMX *amx)
+{
+	static const char *callbackNames[STREAMER_MAX_CALLBACKS] =
+	{
+		"OnDynamicActorStreamIn",
+		"OnDynamicActorStreamOut",
+		"OnDynamicObjectMoved",
+		"OnDynamicTrailerUpdate",
+		"OnDynamicVehDamageStatusUpdate",
+		"OnDynamicVehSirenStateChange",
+		"OnDynamicVehicleDeath",
+		"OnDynamicVehicleMod",
+		"OnDynamicVehiclePaintjob",
+		"OnDynamicVehicleRespray",
+		"OnDynamicVehicleSpawn",
+		"OnDynamicVehicleStreamIn",
+		"OnDynamicVehicleStreamOut",
+		"OnPlayerEditDynamicObject",
+		"OnPlayerEnterDynamicArea",
+		"OnPlayerEnterDynamicAreas",
+		"OnPlayerEnterDynamicCP",
+		"OnPlayerEnterDynamicRaceCP",
+		"OnPlayerEnterDynamicVehicle",
+		"OnPlayerExitDynamicVehicle",
+		"OnPlayerGiveDamageDynamicActor",
+		"OnPlayerLeaveDynamicArea",
+		"OnPlayerLeaveDynamicAreas",
+		"OnPlayerLeaveDynamicCP",
+		"OnPlayerLeaveDynamicRaceCP",
+		"OnPlayerPickUpDynamicPickup",
+		"OnPlayerSelectDynamicObject",
+		"OnPlayerShootDynamicObject",
+		"OnPlayerShootDynamicVehicle",
+		"OnUnoccupiedDynamicVehUpdate",
+		"Streamer_OnItemStreamIn",
+		"Streamer_OnItemStreamOut",
+		"Streamer_OnItemsStreamIn",
+		"Streamer_OnItemsStreamOut",
+		"Streamer_OnPluginError",
+	};
+	static const char *nativeNames[STREAMER_MAX_NATIVES] =
+	{
+		"AttachPlayerObjectToObject",
+		"AttachPlayerObjectToPlayer",
+		"SetPlayerGravity",
+	};
+	std::vector<int> &callbacks = core->getData()->interfaceCallbacks[amx];
+	callbacks.assign(STREAMER_MAX_CALLBACKS, -1);
+	for (int i = 0; i < STREAMER_MAX_CALLBACKS; ++i)
+	{
+		int amxIndex = 0;
+		if (!amx_FindPublic(amx, callbackNames[i], &amxIndex))
+		{
+			callbacks[i] = amxIndex;
+		}
+	}
+	for (int i = 0; i < STREAMER_MAX_NATIVES; ++i)
+	{
+		if (core->getData()->natives[i] == NULL)
+		{
+			core->getData()->natives[i] = sampgdk::FindNative(nativeNames[i]);
+		}
+	}
+}
+
+void Utility::uncacheInterface(AMX *amx)
+{
+	core->getData()->interfaceCallbacks.erase(amx);
+}
+
+bool Utility::findPublic(AMX *amx, int callback, int &amxIndex)
+{
+	boost::unordered_map<AMX*, std::vector<int> >::const_iterator i = core->getData()->interfaceCallbacks.find(amx);
+	if (i != core->getData()->interfaceCallbacks.end())
+	{
+		if (i->second[callback] >= 0)
+		{
+			amxIndex = i->second[callback];
+			return true;
+		}
+	}
+	return false;
+}
+
+AMX_NATIVE Utility::findNative(int native)
+{
+	return core->getData()->natives[native];
+}
+
+void Utility::executeArrayCallback(AMX *amx, int amxIndex, int value, const std::vector<int> &array)
+{
+	if (array.empty())
+	{
+		return;
+	}
+	cell amxAddress = 0, *physicalAddress = NULL;
+	if (amx_Allot(amx, static_cast<int>(array.size()), &amxAddress, &physicalAddress) != AMX_ERR_NONE)
+	{
+		Utility::logError("Insufficient heap space to pass %d items to a batched callback.", static_cast<int>(array.size()));
+		return;
+	}
+	std::copy(array.begin(), array.end(), physicalAddress);
+	amx_Push(amx, static_cast<cell>(array.size()));
+	amx_Push(amx, amxAddress);
+	amx_Push(amx, static_cast<cell>(value));
+	amx_Exec(amx, NULL, amxIndex);
+	amx_Release(amx, amxAddress);
+}
+
+void Utility::executeBatchedCallbacks(int callback, const std::map<int, std::vector<int> > &batches)
+{
+	for (std::set<AMX*>::iterator a = core->getData()->interfaces.begin(); a != core->getData()->interfaces.end(); ++a)
+	{
+		int amxIndex = 0;
+		if (Utility::findPublic(*a, callback, amxIndex))
+		{
+			for (std::map<int, std::vector<int> >::const_iterator b = batches.begin(); b != batches.end(); ++b)
+			{
+				Utility::executeArrayCallback(*a, amxIndex, b->first, b->second);
+			}
+		}
+	}
+}
+
 void Utility::destroyAllItemsInInterface(AMX *amx)
 {
 	boost::unordered_map<int, Item::SharedObject>::iterator o = core->getData()->objects.begin();
@@ -226,12 +352,14 @@ void Utility::executeFinalAreaCallbacks(int areaid)
 			}
 		}
 	}
+	std::map<int, std::vector<int> > batches;
 	for (std::vector<boost::tuple<int, int> >::const_iterator c = callbacks.begin(); c != callbacks.end(); ++c)
 	{
+		batches[c->get<1>()].push_back(c->get<0>());
 		for (std::set<AMX*>::iterator a = core->getData()->interfaces.begin(); a != core->getData()->interfaces.end(); ++a)
 		{
 			int amxIndex = 0;
-			if (!amx_FindPublic(*a, "OnPlayerLeaveDynamicArea", &amxIndex))
+			if (!Utility::findPublic(*a, STREAMER_CALLBACK_ON_PLAYER_LEAVE_DYNAMIC_AREAS, amxIndex) && Utility::findPublic(*a, STREAMER_CALLBACK_ON_PLAYER_LEAVE_DYNAMIC_AREA, amxIndex))
 			{
 				amx_Push(*a, static_cast<cell>(c->get<0>()));
 				amx_Push(*a, static_cast<cell>(c->get<1>()));
@@ -239,6 +367,7 @@ void Utility::executeFinalAreaCallbacks(int areaid)
 			}
 		}
 	}
+	Utility::executeBatchedCallbacks(STREAMER_CALLBACK_ON_PLAYER_LEAVE_DYNAMIC_AREAS, batches);
 }
 
 void Utility::executeFinalAreaCallbacksForAllAreas(AMX *amx, bool ignoreInterface)
@@ -258,12 +387,14 @@ void Utility::executeFinalAreaCallbacksForAllAreas(AMX *amx, bool ignoreInterfac
 			}
 		}
 	}
+	std::map<int, std::vector<int> > batches;
 	for (std::vector<boost::tuple<int, int> >::const_iterator c = callbacks.begin(); c != callbacks.end(); ++c)
 	{
+		batches[c->get<1>()].push_back(c->get<0>());
 		for (std::set<AMX*>::iterator a = core->getData()->interfaces.begin(); a != core->getData()->interfaces.end(); ++a)
 		{
 			int amxIndex = 0;
-			if (!amx_FindPublic(*a, "OnPlayerLeaveDynamicArea", &amxIndex))
+			if (!Utility::findPublic(*a, STREAMER_CALLBACK_ON_PLAYER_LEAVE_DYNAMIC_AREAS, amxIndex) && Utility::findPublic(*a, STREAMER_CALLBACK_ON_PLAYER_LEAVE_DYNAMIC_AREA, amxIndex))
 			{
 				amx_Push(*a, static_cast<cell>(c->get<0>()));
 				amx_Push(*a, static_cast<cell>(c->get<1>()));
@@ -271,6 +402,7 @@ void Utility::executeFinalAreaCallbacksForAllAreas(AMX *amx, bool ignoreInterfac
 			}
 		}
 	}
+	Utility::executeBatchedCallbacks(STREAMER_CALLBACK_ON_PLAYER_LEAVE_DYNAMIC_AREAS, batches);
 }
 
 void Utility::logError(const char *format, ...)
@@ -287,7 +419,7 @@ void Utility::logError(const char *format, ...)
 		{
 			cell amxAddress = 0;
 			int amxIndex = 0;
-			if (!amx_FindPublic(*a, "Streamer_OnPluginError", &amxIndex))
+			if (Utility::findPublic(*a, STREAMER_CALLBACK_ON_PLUGIN_ERROR, amxIndex))
 			{
 				amx_PushString(*a, &amxAddress, NULL, buffer, 0, 0);
 				amx_Exec(*a, NULL, amxIndex);
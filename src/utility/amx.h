@@ -27,7 +27,9 @@
 
 #include <algorithm>
 #include <bitset>
+#include <map>
 #include <string>
+#include <vector>
 
 #define MAX_BUFFER (1024)
 
@@ -36,6 +38,12 @@ namespace Utility
 	cell AMX_NATIVE_CALL hookedNative(AMX *amx, cell *params);
 
 	int checkInterfaceAndRegisterNatives(AMX *amx, AMX_NATIVE_INFO *amxNativeList);
+	void cacheInterface(AMX *amx);
+	void uncacheInterface(AMX *amx);
+	bool findPublic(AMX *amx, int callback, int &amxIndex);
+	AMX_NATIVE findNative(int native);
+	void executeArrayCallback(AMX *amx, int amxIndex, int value, const std::vector<int> &array);
+	void executeBatchedCallbacks(int callback, const std::map<int, std::vector<int> > &batches);
 	void destroyAllItemsInInterface(AMX *amx);
 	void executeFinalAreaCallbacks(int areaid);
 	void executeFinalAreaCallbacksForAllAreas(AMX *amx, bool ignoreInterface);
@@ -39,12 +39,14 @@ boost::unordered_map<int, Item::SharedActor>::iterator Utility::destroyActor(boo
 	if (i != core->getData()->internalActors.end())
 	{
 		core->getData()->destroyedActors.push_back(i->second);
+		core->getData()->reverseActors.erase(i->second);
 		core->getData()->internalActors.quick_erase(i);
 	}
-	boost::unordered_map<int, Item::SharedActor>::iterator d = core->getData()->discoveredActors.find(a->first);
-	if (d != core->getData()->discoveredActors.end())
+	core->getData()->discoveredActors.erase(a->first);
+	core->getData()->actorReferences.erase(a->first);
+	for (boost::unordered_map<int, Player>::iterator p = core->getData()->players.begin(); p != core->getData()->players.end(); ++p)
 	{
-		core->getData()->discoveredActors.erase(d);
+		p->second.referencedActors.erase(a->first);
 	}
 	core->getGrid()->removeActor(a->second);
 	return core->getData()->actors.erase(a);
@@ -55,8 +57,10 @@ boost::unordered_map<int, Item::SharedArea>::iterator Utility::destroyArea(boost
 	Item::Area::identifier.remove(a->first, core->getData()->areas.size());
 	for (boost::unordered_map<int, Player>::iterator p = core->getData()->players.begin(); p != core->getData()->players.end(); ++p)
 	{
-		p->second.internalAreas.erase(a->first);
-		p->second.visibleCell->areas.erase(a->first);
+		if (p->second.internalAreas.erase(a->first))
+		{
+			++p->second.internalAreasVersion;
+		}
 	}
 	core->getGrid()->removeArea(a->second);
 	return core->getData()->areas.erase(a);
@@ -89,6 +93,7 @@ boost::unordered_map<int, Item::SharedMapIcon>::iterator Utility::destroyMapIcon
 		{
 			sampgdk::RemovePlayerMapIcon(p->first, i->second);
 			p->second.mapIconIdentifier.remove(i->second, p->second.internalMapIcons.size());
+			p->second.streamedMapIcons.erase(i->first);
 			p->second.internalMapIcons.quick_erase(i);
 		}
 		p->second.visibleCell->mapIcons.erase(m->first);
@@ -106,6 +111,8 @@ boost::unordered_map<int, Item::SharedObject>::iterator Utility::destroyObject(b
 		if (i != p->second.internalObjects.end())
 		{
 			sampgdk::DestroyPlayerObject(p->first, i->second);
+			p->second.streamedObjects.erase(i->first);
+			p->second.reverseObjects.erase(i->second);
 			p->second.internalObjects.quick_erase(i);
 		}
 		p->second.visibleCell->objects.erase(o->first);
@@ -121,12 +128,14 @@ boost::unordered_map<int, Item::SharedPickup>::iterator Utility::destroyPickup(b
 	if (i != core->getData()->internalPickups.end())
 	{
 		sampgdk::DestroyPickup(i->second);
+		core->getData()->reversePickups.erase(i->second);
 		core->getData()->internalPickups.quick_erase(i);
 	}
-	boost::unordered_map<int, Item::SharedPickup>::iterator d = core->getData()->discoveredPickups.find(p->first);
-	if (d != core->getData()->discoveredPickups.end())
+	core->getData()->discoveredPickups.erase(p->first);
+	core->getData()->pickupReferences.erase(p->first);
+	for (boost::unordered_map<int, Player>::iterator q = core->getData()->players.begin(); q != core->getData()->players.end(); ++q)
 	{
-		core->getData()->discoveredPickups.erase(d);
+		q->second.referencedPickups.erase(p->first);
 	}
 	core->getGrid()->removePickup(p->second);
 	return core->getData()->pickups.erase(p);
@@ -158,6 +167,8 @@ boost::unordered_map<int, Item::SharedTextLabel>::iterator Utility::destroyTextL
 		if (i != p->second.internalTextLabels.end())
 		{
 			sampgdk::DeletePlayer3DTextLabel(p->first, i->second);
+			p->second.streamedTextLabels.erase(i->first);
+			p->second.reverseTextLabels.erase(i->second);
 			p->second.internalTextLabels.quick_erase(i);
 		}
 		p->second.visibleCell->textLabels.erase(t->first);
@@ -173,17 +184,68 @@ boost::unordered_map<int, Item::SharedVehicle>::iterator Utility::destroyVehicle
 	if (i != core->getData()->internalVehicles.end())
 	{
 		sampgdk::DestroyVehicle(i->second);
+		core->getData()->reverseVehicles.erase(i->second);
 		core->getData()->internalVehicles.quick_erase(i);
 	}
-	boost::unordered_map<int, Item::SharedVehicle>::iterator d = core->getData()->discoveredVehicles.find(v->first);
-	if (d != core->getData()->discoveredVehicles.end())
+	core->getData()->discoveredVehicles.erase(v->first);
+	core->getData()->vehicleReferences.erase(v->first);
+	for (boost::unordered_map<int, Player>::iterator p = core->getData()->players.begin(); p != core->getData()->players.end(); ++p)
 	{
-		core->getData()->discoveredVehicles.erase(d);
+		p->second.referencedVehicles.erase(v->first);
 	}
 	core->getGrid()->removeVehicle(v->second);
 	return core->getData()->vehicles.erase(v);
 }
 
+std::size_t Utility::getChunkByteBudget(int type, int playerid)
+{
+	if (playerid >= 0 && playerid < MAX_PLAYERS)
+	{
+		boost::unordered_map<int, Player>::iterator p = core->getData()->players.find(playerid);
+		if (p != core->getData()->players.end())
+		{
+			switch (type)
+			{
+				case STREAMER_TYPE_OBJECT:
+				{
+					return p->second.chunkByteBudget[STREAMER_TYPE_OBJECT];
+				}
+				case STREAMER_TYPE_MAP_ICON:
+				{
+					return p->second.chunkByteBudget[STREAMER_TYPE_MAP_ICON];
+				}
+				case STREAMER_TYPE_3D_TEXT_LABEL:
+				{
+					return p->second.chunkByteBudget[STREAMER_TYPE_3D_TEXT_LABEL];
+				}
+			}
+		}
+	}
+	return core->getData()->getGlobalChunkByteBudget(type);
+}
+
+bool Utility::setChunkByteBudget(int type, std::size_t value, int playerid)
+{
+	if (type != STREAMER_TYPE_OBJECT && type != STREAMER_TYPE_MAP_ICON && type != STREAMER_TYPE_3D_TEXT_LABEL)
+	{
+		return false;
+	}
+	if (playerid >= 0 && playerid < MAX_PLAYERS)
+	{
+		boost::unordered_map<int, Player>::iterator p = core->getData()->players.find(playerid);
+		if (p != core->getData()->players.end())
+		{
+			p->second.chunkByteBudget[type] = value;
+			return true;
+		}
+	}
+	for (boost::unordered_map<int, Player>::iterator p = core->getData()->players.begin(); p != core->getData()->players.end(); ++p)
+	{
+		p->second.chunkByteBudget[type] = value;
+	}
+	return core->getData()->setGlobalChunkByteBudget(type, value);
+}
+
 std::size_t Utility::getChunkTickRate(int type, int playerid)
 {
 	if (playerid >= 0 && playerid < MAX_PLAYERS)
@@ -360,74 +422,73 @@ bool Utility::setRadiusMultiplier(int type, float value, int playerid)
 			if (p != core->getData()->players.end())
 			{
 				p->second.radiusMultipliers[type] = value;
+				++p->second.candidateUpdate;
 				return true;
 			}
 		}
 		for (boost::unordered_map<int, Player>::iterator p = core->getData()->players.begin(); p != core->getData()->players.end(); ++p)
 		{
 			p->second.radiusMultipliers[type] = value;
+			++p->second.candidateUpdate;
 		}
 	}
 	return core->getData()->setGlobalRadiusMultiplier(type, value);
 }
 
-bool Utility::haveAllPlayersCheckedActors()
+void Utility::processPendingDestroyedActors()
 {
-	if (!core->getData()->players.empty())
+	if (!core->getData()->destroyedActors.empty())
 	{
-		for (boost::unordered_map<int, Player>::iterator p = core->getData()->players.begin(); p != core->getData()->players.end(); ++p)
+		std::vector<int>::iterator a = core->getData()->destroyedActors.begin();
+		while (a != core->getData()->destroyedActors.end())
 		{
-			if (!p->second.checkedActors && p->second.enabledItems[STREAMER_TYPE_ACTOR])
-			{
-				return false;
-			}
+			sampgdk::DestroyActor(*a);
+			a = core->getData()->destroyedActors.erase(a);
 		}
-		return true;
 	}
-	return false;
 }
 
-bool Utility::haveAllPlayersCheckedPickups()
+bool Utility::isVehicleOccupied(int vehicleid)
 {
-	if (!core->getData()->players.empty())
+	boost::unordered_map<int, int>::iterator d = core->getData()->vehicleDrivers.find(vehicleid);
+	if (d != core->getData()->vehicleDrivers.end())
 	{
-		for (boost::unordered_map<int, Player>::iterator p = core->getData()->players.begin(); p != core->getData()->players.end(); ++p)
+		int playerid = d->second;
+		if (sampgdk::GetPlayerState(playerid) == PLAYER_STATE_DRIVER)
 		{
-			if (!p->second.checkedPickups && p->second.enabledItems[STREAMER_TYPE_PICKUP])
+			int drivenVehicleID = sampgdk::GetPlayerVehicleID(playerid);
+			if (drivenVehicleID == vehicleid)
 			{
-				return false;
+				return true;
 			}
+			setPlayerDrivenVehicle(playerid, drivenVehicleID);
 		}
-		return true;
-	}
-	return false;
-}
-
-void Utility::processPendingDestroyedActors()
-{
-	if (!core->getData()->destroyedActors.empty())
-	{
-		std::vector<int>::iterator a = core->getData()->destroyedActors.begin();
-		while (a != core->getData()->destroyedActors.end())
+		else
 		{
-			sampgdk::DestroyActor(*a);
-			a = core->getData()->destroyedActors.erase(a);
+			setPlayerDrivenVehicle(playerid, INVALID_VEHICLE_ID);
 		}
 	}
+	return false;
 }
 
-bool Utility::haveAllPlayersCheckedVehicles()
+void Utility::setPlayerDrivenVehicle(int playerid, int vehicleid)
 {
-	if (!core->getData()->players.empty())
+	boost::unordered_map<int, Player>::iterator p = core->getData()->players.find(playerid);
+	if (p != core->getData()->players.end())
 	{
-		for (boost::unordered_map<int, Player>::iterator p = core->getData()->players.begin(); p != core->getData()->players.end(); ++p)
+		if (p->second.drivenVehicleID != INVALID_VEHICLE_ID)
 		{
-			if (!p->second.checkedVehicles && p->second.enabledItems[STREAMER_TYPE_VEHICLE])
+			boost::unordered_map<int, int>::iterator d = core->getData()->vehicleDrivers.find(p->second.drivenVehicleID);
+			if (d != core->getData()->vehicleDrivers.end() && d->second == playerid)
 			{
-				return false;
+				core->getData()->vehicleDrivers.erase(d);
 			}
 		}
-		return true;
+		p->second.drivenVehicleID = vehicleid;
+		if (vehicleid != INVALID_VEHICLE_ID)
+		{
+			core->getData()->vehicleDrivers[vehicleid] = playerid;
+			core->getData()->drivenVehicles.push_back(vehicleid);
+		}
 	}
-	return false;
 }
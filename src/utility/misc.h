@@ -37,6 +37,9 @@ namespace Utility
 	boost::unordered_map<int, Item::SharedTextLabel>::iterator destroyTextLabel(boost::unordered_map<int, Item::SharedTextLabel>::iterator t);
 	boost::unordered_map<int, Item::SharedVehicle>::iterator destroyVehicle(boost::unordered_map<int, Item::SharedVehicle>::iterator v);
 
+	std::size_t getChunkByteBudget(int type, int playerid);
+	bool setChunkByteBudget(int type, std::size_t value, int playerid);
+
 	std::size_t getChunkTickRate(int type, int playerid);
 	bool setChunkTickRate(int type, std::size_t value, int playerid);
 
@@ -46,12 +49,11 @@ namespace Utility
 	float getRadiusMultiplier(int type, int playerid);
 	bool setRadiusMultiplier(int type, float value, int playerid);
 
-	bool haveAllPlayersCheckedActors();
-	bool haveAllPlayersCheckedPickups();
-	bool haveAllPlayersCheckedVehicles();
-
 	void processPendingDestroyedActors();
 
+	bool isVehicleOccupied(int vehicleid);
+	void setPlayerDrivenVehicle(int playerid, int vehicleid);
+
 	template<typename T>
 	inline bool almostEquals(T a, T b)
 	{